@@ -18,6 +18,11 @@ CONFIG(release, debug|release) {
     CONFIG += optimize_full
 }
 
+# Uncomment to let Json::parseCompressed() pipeline zlib decompression with parsing instead of the
+# default one-shot qUncompress fallback. Requires linking zlib.
+#DEFINES += JSON_HAS_ZLIB
+#LIBS += -lz
+
 SOURCES += \
         src/main.cpp \
         src/Json.cpp \
@@ -26,21 +26,44 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Json.h"
 
 #include <QFile>
+#include <QIODevice>
 #include <QMetaType>
 #include <QtDebug>
 #include <QVariant>
 
 #include <algorithm>
 #include <array>
-#include <cinttypes>
+#include <atomic>
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
 #include <clocale>
 #include <cmath>
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <limits>
 #include <mutex>
+#include <thread>
 #include <type_traits>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+// zlib, when the build opts in (-DJSON_HAS_ZLIB and link -lz; see CMakeLists.txt / Json.pro), lets
+// parseCompressed() pipeline decompression with parsing. This is deliberately not auto-detected via
+// __has_include: merely having the headers doesn't mean the build links zlib, and drop-in consumers
+// of these sources should pick up no new link dependency. Default is the one-shot qUncompress path.
+#ifdef JSON_HAS_ZLIB
+#include <zlib.h>
+#define HAVE_ZLIB 1
+#else
+#define HAVE_ZLIB 0
+#endif
+
 #ifdef __clang__
 // turn off the dreaded "warning: class padded with xx bytes, etc" since we aren't writing wire protocols using structs..
 #pragma clang diagnostic ignored "-Wpadded"
@@ -59,9 +82,83 @@ namespace {
     // JSON escapes -- used in jsonEscape()
     extern const std::array<const char *, 256> escapes;
 
+    // two-digits-at-a-time lookup table for the integer-to-ascii kernel in writeIntOrFloat()
+    const char digitPairs[201] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+
+    /// Returns a pointer to the first byte in [p, end) that requires escaping in a JSON string
+    /// (anything < 0x20, '"', '\\', or 0x7f -- i.e. exactly the non-null entries in `escapes`),
+    /// or `end` if the whole range is clean. Scans 16 bytes at a time where SIMD is available;
+    /// in typical payloads >99% of string bytes are clean so most input is skipped in blocks.
+    const char *findFirstEscapeChar(const char *p, const char * const end) noexcept
+    {
+#if defined(__SSE2__)
+        const __m128i limit = _mm_set1_epi8(0x1f);
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i slash = _mm_set1_epi8('\\');
+        const __m128i del = _mm_set1_epi8(0x7f);
+        for (; end - p >= 16; p += 16) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+            __m128i m = _mm_cmpeq_epi8(_mm_min_epu8(v, limit), v); // unsigned v <= 0x1f
+            m = _mm_or_si128(m, _mm_cmpeq_epi8(v, quote));
+            m = _mm_or_si128(m, _mm_cmpeq_epi8(v, slash));
+            m = _mm_or_si128(m, _mm_cmpeq_epi8(v, del));
+            if (_mm_movemask_epi8(m))
+                break; // some byte in this block needs escaping; the scalar loop below pinpoints it
+        }
+#elif defined(__aarch64__)
+        for (; end - p >= 16; p += 16) {
+            const uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t *>(p));
+            uint8x16_t m = vcltq_u8(v, vdupq_n_u8(0x20));
+            m = vorrq_u8(m, vceqq_u8(v, vdupq_n_u8('"')));
+            m = vorrq_u8(m, vceqq_u8(v, vdupq_n_u8('\\')));
+            m = vorrq_u8(m, vceqq_u8(v, vdupq_n_u8(0x7f)));
+            if (vmaxvq_u8(m))
+                break; // some byte in this block needs escaping; the scalar loop below pinpoints it
+        }
+#endif
+        while (p < end && !escapes[uint8_t(*p)])
+            ++p;
+        return p;
+    }
+
     // Opaque type used for writing. This can be further optimized later.
     struct Writer {
         QByteArray & buf; // this is a reference for RVO to always work in write() below
+        QIODevice *device = nullptr;  ///< if non-null, buf is flushed here whenever it grows past flushThreshold
+        size_t flushThreshold = 0;
+
+        /// Drain buf to the device (if any); throws Json::Error if the device write fails.
+        void flush() {
+            if (!device || buf.isEmpty())
+                return;
+            const char *p = buf.constData();
+            qint64 remain = buf.size();
+            while (remain > 0) {
+                const qint64 n = device->write(p, remain);
+                if (UNLIKELY(n < 0))
+                    throw Json::Error(QString("Error writing to device: %1").arg(device->errorString()));
+                p += n;
+                remain -= n;
+            }
+            buf.resize(0); // note: not clear(), which would release the capacity we want to reuse
+        }
+        /// Called between elements when walking containers -- keeps memory bounded in device mode,
+        /// and is a single predicted-not-taken branch in (the common) buffer-only mode.
+        void maybeFlush() {
+            if (UNLIKELY(device && size_t(buf.size()) >= flushThreshold))
+                flush();
+        }
+
         void put(char c) { buf.push_back(c); }
         void put(char c, size_t nFill) { buf.append(int(nFill), c); }
         void write(const char *s, size_t len) { buf.append(s, len); }
@@ -72,37 +169,73 @@ namespace {
 
         template<typename Num>
         bool writeIntOrFloat(Num num) {
-            constexpr int bufSize = std::is_integral<Num>::value ? 32 : 64; // use 32 byte buffer for ints, 64 for double
-            constexpr auto fmt =
-                    std::is_same<Num, double>::value
-                    ? "%1.16g"
-                    : (std::is_same<Num, int64_t>::value
-                       ? "%" PRId64
-                       : (std::is_same<Num, uint64_t>::value
-                          ? "%" PRIu64
-                            // this is here to enforce uint64_t, int64_t or double (if evaluated will fail at compile-time)
-                          : throw std::runtime_error("Unexpected type")));
-            if constexpr (std::is_floating_point<Num>::value) {
+            // enforce uint64_t, int64_t or double only
+            static_assert (std::is_same_v<Num, double> || std::is_same_v<Num, int64_t> || std::is_same_v<Num, uint64_t>);
+            if constexpr (std::is_floating_point_v<Num>) {
                 // ensure not NaN or inf, which are not representable by the JSON Number type
                 if (!std::isfinite(num))
                     return false;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+                // shortest round-trip formatting; locale-independent and much faster than printf machinery
+                std::array<char, 32> tmp;
+                const auto res = std::to_chars(tmp.data(), tmp.data() + tmp.size(), num);
+                if (UNLIKELY(res.ec != std::errc{})) // should never happen
+                    return false;
+                write(tmp.data(), size_t(res.ptr - tmp.data()));
+#else
+                // fallback for toolchains lacking floating-point std::to_chars -- snprintf honors
+                // LC_NUMERIC, so this (rare) path is the one place serialization still needs the check
+                Json::detail::ensureLocaleChecked();
+                std::array<char, 64> tmp;
+                const int n = std::snprintf(tmp.data(), tmp.size(), "%1.16g", num); // C++11 snprintf always NUL terminates
+                if (UNLIKELY(n <= 0 || n >= int(tmp.size()))) // should never happen
+                    return false;
+                write(tmp.data(), size_t(n));
+#endif
+            } else {
+                // integer-to-ascii kernel: emit two digits at a time from the lookup table, right-to-left
+                std::array<char, 24> tmp; // uint64 max is 20 digits; int64 min is 19 digits + sign
+                char * const bufEnd = tmp.data() + tmp.size();
+                uint64_t u;
+                bool neg = false;
+                if constexpr (std::is_signed_v<Num>) {
+                    neg = num < 0;
+                    u = neg ? 0u - uint64_t(num) : uint64_t(num); // negate in unsigned space; ok for INT64_MIN
+                } else
+                    u = num;
+                char *p = bufEnd;
+                while (u >= 100u) {
+                    const uint64_t q = u / 100u, r = u - q * 100u;
+                    p -= 2;
+                    std::memcpy(p, &digitPairs[r * 2], 2);
+                    u = q;
+                }
+                if (u >= 10u) {
+                    p -= 2;
+                    std::memcpy(p, &digitPairs[u * 2], 2);
+                } else
+                    *--p = char('0' + u);
+                if (neg)
+                    *--p = '-';
+                write(p, size_t(bufEnd - p));
             }
-            std::array<char, bufSize> tmp;
-            int n = std::snprintf(tmp.data(), size_t(bufSize), fmt, num); // C++11 snprintf always NUL terminates
-            if (n <= 0 || n >= bufSize) // should never happen
-                return false;
-            write(tmp.data(), size_t(n));
             return true;
         }
 
         void jsonEscape(const QByteArray & inS) {
-            for (const auto ch : inS) {
-                const char * const escStr = escapes[uint8_t(ch)];
-
-                if (escStr)
-                    *this << escStr;
-                else
-                    put(ch);
+            const char *p = inS.constData();
+            const char * const end = p + inS.size();
+            while (p < end) {
+                const char * const runEnd = findFirstEscapeChar(p, end);
+                if (runEnd != p) {
+                    write(p, size_t(runEnd - p)); // bulk-append the clean run in one go
+                    p = runEnd;
+                }
+                if (p < end) {
+                    JSON_STAT_ADD(escapeSlowPathHits, 1);
+                    *this << escapes[uint8_t(*p)]; // non-null by findFirstEscapeChar()'s postcondition
+                    ++p;
+                }
             }
         }
 
@@ -122,6 +255,67 @@ namespace {
     const QByteArray TrueLiteral = QByteArrayLiteral("true");
     const QByteArray FalseLiteral = QByteArrayLiteral("false");
 
+    /// Fast pre-pass over the QVariant tree used by Json::serialize() to estimate the final output size
+    /// so the buffer can be reserved once up-front. This does no formatting or escaping so it is much
+    /// cheaper than serialization proper; it only needs to land in the right ballpark (a slightly-off
+    /// estimate merely costs one realloc at the end rather than dozens along the way).
+    size_t estimateSize(const QVariant &v, unsigned prettyIndent, unsigned indentLevel)
+    {
+        constexpr size_t NumberSize = 20; // generous guess covering most ints & shortest-round-trip doubles
+        const auto typ = QMetaType::Type(v.type());
+        // per-element whitespace cost in pretty mode: indentation plus a newline
+        const size_t prettyOverhead = prettyIndent ? size_t(prettyIndent) * (indentLevel + 1) + 1 : 0;
+        switch (typ) {
+        case QMetaType::QByteArray:
+            return size_t(v.toByteArray().size()) + 2;
+        case QMetaType::QString: {
+            // QString::size() is in UTF-16 units; utf8 output is 1 byte per unit for ASCII and up to 3
+            // for the rest -- payloads here are overwhelmingly ASCII, so add a small slack only
+            const size_t len = size_t(v.toString().size());
+            return len + len / 8 + 2;
+        }
+        case QMetaType::QStringList: {
+            const auto sl = v.toStringList();
+            size_t est = 2 + (prettyIndent ? 2 : 0);
+            for (const auto &s : sl)
+                est += size_t(s.size()) + size_t(s.size()) / 8 + 3 + prettyOverhead;
+            return est;
+        }
+        case QMetaType::QByteArrayList: {
+            const auto bal = v.value<QByteArrayList>();
+            size_t est = 2 + (prettyIndent ? 2 : 0);
+            for (const auto &ba : bal)
+                est += size_t(ba.size()) + 3 + prettyOverhead;
+            return est;
+        }
+        case QMetaType::QVariantList: {
+            const auto vl = v.toList();
+            size_t est = 2 + (prettyIndent ? 2 : 0);
+            for (const auto &el : vl)
+                est += estimateSize(el, prettyIndent, indentLevel + 1) + 1 + prettyOverhead;
+            return est;
+        }
+        case QMetaType::QVariantMap: {
+            const auto vm = v.toMap();
+            size_t est = 2 + (prettyIndent ? 2 : 0);
+            for (auto it = vm.begin(), e = vm.end(); it != e; ++it)
+                est += size_t(it.key().size()) + 5 + estimateSize(it.value(), prettyIndent, indentLevel + 1)
+                       + prettyOverhead;
+            return est;
+        }
+        case QMetaType::QVariantHash: {
+            const auto vh = v.toHash();
+            size_t est = 2 + (prettyIndent ? 2 : 0);
+            for (auto it = vh.begin(), e = vh.end(); it != e; ++it)
+                est += size_t(it.key().size()) + 5 + estimateSize(it.value(), prettyIndent, indentLevel + 1)
+                       + prettyOverhead;
+            return est;
+        }
+        default:
+            return NumberSize; // numbers, bools, nulls, etc
+        }
+    }
+
 
     void Writer::writeVariant(const QVariant &v, unsigned prettyIndent, unsigned indentLevel) noexcept(false)
     {
@@ -230,6 +424,7 @@ namespace {
             }
             if (prettyIndent)
                 put('\n');
+            maybeFlush();
         }
 
         if (prettyIndent)
@@ -259,6 +454,7 @@ namespace {
                 put(',');
             if (prettyIndent)
                 put('\n');
+            maybeFlush();
         }
 
         if (prettyIndent)
@@ -274,6 +470,22 @@ namespace Json {
 
     bool autoFixLocale = true; // Not atomic for performance. Assumption is this is set by client code before threads are started.
 
+#ifdef JSON_ENABLE_STATS
+    thread_local Stats detail::stats;
+#endif
+    Stats statsSnapshot() noexcept {
+#ifdef JSON_ENABLE_STATS
+        return detail::stats;
+#else
+        return {};
+#endif
+    }
+    void statsReset() noexcept {
+#ifdef JSON_ENABLE_STATS
+        detail::stats = Stats{};
+#endif
+    }
+
     bool checkLocale(bool autoFix) {
         const auto *const lconv = std::localeconv();
         // check that the decimal point is ".", otherwise we will produce bad Json on serialize
@@ -303,41 +515,637 @@ namespace Json {
 
     namespace { std::once_flag once_checkLocale; }
 
-    QByteArray serialize(const QVariant &v, unsigned prettyIndent, unsigned indentLevel)
+    void detail::ensureLocaleChecked()
     {
         if (autoFixLocale)
             checkLocale(true);
         else
             std::call_once(once_checkLocale, checkLocale, false);
+    }
+
+    QByteArray serialize(const QVariant &v, unsigned prettyIndent, unsigned indentLevel, std::size_t sizeHint)
+    {
         QByteArray ba; // we do it this way for RVO to work on all compilers
         Writer writer{ba};
-        ba.reserve(1024);
+        if (!sizeHint)
+            sizeHint = std::max<size_t>(1024, estimateSize(v, prettyIndent, indentLevel));
+        ba.reserve(int(std::min<size_t>(sizeHint, size_t(std::numeric_limits<int>::max()))));
         writer.writeVariant(v, prettyIndent, indentLevel); // this may throw
         return ba;
     }
 
-    QVariant parseUtf8(const QByteArray &ba, ParseOption opt, ParserBackend backend)
+    QByteArray serializeParallel(const QVariant &v, unsigned prettyIndent, int maxThreads)
     {
-        if (autoFixLocale)
-            checkLocale(true);
+        constexpr int MinElems = 256; // below this, thread spawn overhead dominates any speedup
+        unsigned nThreads = maxThreads > 0 ? unsigned(maxThreads) : std::thread::hardware_concurrency();
+        if (prettyIndent != 0 || QMetaType::Type(v.type()) != QMetaType::QVariantList || nThreads <= 1)
+            return serialize(v, prettyIndent); // parallel mode only pays off for large compact top-level arrays
+        const QVariantList vl = v.toList();
+        const int nElems = vl.size();
+        if (nElems < MinElems)
+            return serialize(v, prettyIndent);
+
+        nThreads = std::max(1U, std::min(nThreads, unsigned(nElems) / 64U));
+        // a few chunks per worker smooths out unevenly-sized elements; every chunk holds >= 1 element
+        const unsigned nChunks = std::min(nThreads * 4, unsigned(nElems));
+
+        std::vector<QByteArray> chunkBufs(nChunks);
+        std::atomic_uint nextChunk{0};
+        std::atomic_bool failed{false};
+        std::exception_ptr firstError;
+        std::mutex errorMut;
+
+        const auto worker = [&] {
+            for (;;) {
+                const unsigned c = nextChunk.fetch_add(1, std::memory_order_relaxed);
+                if (c >= nChunks || failed.load(std::memory_order_relaxed))
+                    return;
+                try {
+                    const int lo = int(qint64(c) * nElems / nChunks), hi = int(qint64(c + 1) * nElems / nChunks);
+                    QByteArray &buf = chunkBufs[c];
+                    Writer writer{buf};
+                    buf.reserve(4096);
+                    for (int i = lo; i < hi; ++i) {
+                        if (i != lo)
+                            writer.put(',');
+                        writer.writeVariant(vl.at(i), 0, 0); // const access -- no COW detach across threads
+                    }
+                } catch (...) {
+                    failed = true;
+                    std::unique_lock g(errorMut);
+                    if (!firstError)
+                        firstError = std::current_exception();
+                    return;
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(nThreads - 1);
+        for (unsigned t = 0; t + 1 < nThreads; ++t)
+            threads.emplace_back(worker);
+        worker(); // the calling thread participates too
+        for (auto &thr : threads)
+            thr.join();
+
+        if (failed)
+            std::rethrow_exception(firstError);
+
+        // ordered (scatter/gather) concatenation
+        size_t total = 2 + size_t(nChunks - 1);
+        for (const auto &buf : chunkBufs)
+            total += size_t(buf.size());
+        QByteArray ret;
+        ret.reserve(int(std::min<size_t>(total, size_t(std::numeric_limits<int>::max()))));
+        ret.append('[');
+        for (unsigned c = 0; c < nChunks; ++c) {
+            if (c)
+                ret.append(',');
+            ret.append(chunkBufs[c]);
+        }
+        ret.append(']');
+        return ret;
+    }
+
+    void serializeToDevice(const QVariant &v, QIODevice &device, unsigned prettyIndent, unsigned indentLevel,
+                           std::size_t chunkSize)
+    {
+        if (UNLIKELY(!device.isOpen() || !(device.openMode() & QIODevice::WriteOnly)))
+            throw Error("serializeToDevice: device is not open for writing");
+        QByteArray ba;
+        Writer writer{ba, &device, std::max<size_t>(chunkSize, 4096)};
+        // reserve a bit over the threshold since we only flush *after* crossing it mid-element
+        ba.reserve(int(std::min<size_t>(writer.flushThreshold + writer.flushThreshold / 4,
+                                        size_t(std::numeric_limits<int>::max()))));
+        writer.writeVariant(v, prettyIndent, indentLevel); // this may throw
+        writer.flush();
+    }
+
+    struct Builder::Impl {
+        QByteArray buf;
+        Writer writer{buf};
+        unsigned prettyIndent = 0;
+        struct Frame { bool isObj; bool first = true; };
+        std::vector<Frame> frames;
+        bool keyPending = false;  ///< true after key(), until its value arrives
+        bool rootWritten = false; ///< true once the top-level value has been (or started being) written
+
+        /// Emits the per-element separator/indent for the innermost container. The trick that keeps the
+        /// output byte-identical to Writer::writeArray()/writeObject() despite us not knowing in advance
+        /// which element is the last: emit ",\n" *before* every element but the first, rather than after
+        /// every element but the last.
+        void elementPrologue() {
+            Frame &f = frames.back();
+            if (!f.first) {
+                writer.put(',');
+                if (prettyIndent)
+                    writer.put('\n');
+            }
+            f.first = false;
+            if (prettyIndent)
+                writer.indentStr(prettyIndent, unsigned(frames.size()));
+        }
+
+        /// Grammar check + positioning done before every value (scalar or container opener).
+        void valuePrologue() {
+            if (frames.empty()) {
+                if (UNLIKELY(rootWritten))
+                    throw Error("Builder: document already contains a complete top-level value");
+                rootWritten = true;
+            } else if (frames.back().isObj) {
+                if (UNLIKELY(!keyPending))
+                    throw Error("Builder: a value inside an object must be preceded by key()");
+                keyPending = false; // key() already emitted the separator, indent and `"key": ` prefix
+            } else {
+                elementPrologue();
+            }
+        }
+
+        void beginContainer(bool isObj) {
+            valuePrologue();
+            writer.put(isObj ? '{' : '[');
+            if (prettyIndent)
+                writer.put('\n');
+            frames.push_back({isObj, true});
+        }
+
+        void endContainer(bool isObj) {
+            if (UNLIKELY(frames.empty() || frames.back().isObj != isObj))
+                throw Error(isObj ? "Builder: endObject() does not match an open beginObject()"
+                                  : "Builder: endArray() does not match an open beginArray()");
+            if (UNLIKELY(keyPending))
+                throw Error("Builder: dangling key() with no value at container end");
+            const Frame f = frames.back();
+            if (prettyIndent) {
+                if (!f.first)
+                    writer.put('\n');
+                writer.indentStr(prettyIndent, unsigned(frames.size()) - 1);
+            }
+            writer.put(isObj ? '}' : ']');
+            frames.pop_back();
+        }
+    };
+
+    Builder::Builder(unsigned prettyIndent) : p(std::make_unique<Impl>()) {
+        p->prettyIndent = prettyIndent;
+    }
+    Builder::~Builder() = default; // out-of-line for ~Impl
+    Builder::Builder(Builder &&) noexcept = default;
+    Builder &Builder::operator=(Builder &&) noexcept = default;
+
+    Builder &Builder::beginObject() { p->beginContainer(true); return *this; }
+    Builder &Builder::endObject() { p->endContainer(true); return *this; }
+    Builder &Builder::beginArray() { p->beginContainer(false); return *this; }
+    Builder &Builder::endArray() { p->endContainer(false); return *this; }
+
+    Builder &Builder::key(QStringView k) {
+        auto &d = *p;
+        if (UNLIKELY(d.frames.empty() || !d.frames.back().isObj))
+            throw Error("Builder: key() is only valid inside an object");
+        if (UNLIKELY(d.keyPending))
+            throw Error("Builder: key() called twice with no intervening value");
+        d.elementPrologue();
+        d.writer.put('"'); d.writer.jsonEscape(k.toUtf8()); d.writer.write("\":", 2);
+        if (d.prettyIndent)
+            d.writer.put(' ');
+        d.keyPending = true;
+        return *this;
+    }
+
+    Builder &Builder::value(std::nullptr_t) {
+        p->valuePrologue();
+        p->writer.write(NullLiteral);
+        return *this;
+    }
+    Builder &Builder::value(bool b) {
+        p->valuePrologue();
+        p->writer.write(b ? TrueLiteral : FalseLiteral);
+        return *this;
+    }
+    Builder &Builder::value(qlonglong i) {
+        p->valuePrologue();
+        p->writer.writeIntOrFloat(int64_t(i)); // cannot fail for integers
+        return *this;
+    }
+    Builder &Builder::value(qulonglong u) {
+        p->valuePrologue();
+        p->writer.writeIntOrFloat(uint64_t(u)); // cannot fail for integers
+        return *this;
+    }
+    Builder &Builder::value(double d) {
+        p->valuePrologue();
+        if (UNLIKELY(!p->writer.writeIntOrFloat(d)))
+            throw Error("Builder: unable to serialize a non-finite double");
+        return *this;
+    }
+    Builder &Builder::value(QStringView s) {
+        p->valuePrologue();
+        p->writer.writeString(s.toUtf8());
+        return *this;
+    }
+    Builder &Builder::value(const QByteArray &utf8) {
+        p->valuePrologue();
+        if (utf8.isEmpty())
+            p->writer.write(NullLiteral); // empty QByteArray is treated specially in this codebase as `null`
         else
-            std::call_once(once_checkLocale, checkLocale, false);
+            p->writer.writeString(utf8);
+        return *this;
+    }
+    Builder &Builder::value(const QVariant &v) {
+        auto &d = *p;
+        d.valuePrologue();
+        // frames.size() + 1 replicates the indentLevel the recursive writer would see for this subtree
+        // (for a bare top-level value this passes 1, which matches writeVariant's max(indentLevel, 1U)).
+        d.writer.writeVariant(v, d.prettyIndent, unsigned(d.frames.size()) + 1); // this may throw
+        return *this;
+    }
+
+    QByteArray Builder::take() {
+        auto &d = *p;
+        if (UNLIKELY(!d.frames.empty()))
+            throw Error("Builder: take() called with container(s) still open");
+        if (UNLIKELY(!d.rootWritten))
+            throw Error("Builder: take() called on an empty document");
+        QByteArray ret;
+        ret.swap(d.buf); // Writer keeps a reference to d.buf, which remains valid (and now empty) for reuse
+        d.rootWritten = false;
+        return ret;
+    }
+
+    namespace {
+        /// Wire format shared by Json::toBinary()/parseBinary(): a 4-byte header (magic + version),
+        /// then one recursively-encoded value. Scalars are a tag plus a fixed-width little-endian
+        /// payload; strings/bytes are a tag plus varint byte length plus raw data (no escaping);
+        /// containers are a tag plus varint element count plus their encoded children (object keys are
+        /// bare varint-length-prefixed utf8 -- keys are always strings, so they carry no tag).
+        namespace BinFmt {
+            constexpr char Magic[4] = { '\xb1', 'J', 'B', /* version: */ 1 };
+            enum Tag : uint8_t { Null = 0, False, True, Int64, UInt64, Double, String, Bytes, Array, Object, ObjectH };
+        }
+
+        void binPutVarint(Writer &w, uint64_t v) { // LEB128
+            while (v >= 0x80u) {
+                w.put(char(uint8_t(v) | 0x80u));
+                v >>= 7;
+            }
+            w.put(char(uint8_t(v)));
+        }
+        void binPutFixed64(Writer &w, uint64_t v) { // little-endian
+            char b[8];
+            for (int i = 0; i < 8; ++i, v >>= 8)
+                b[i] = char(uint8_t(v));
+            w.write(b, sizeof(b));
+        }
+        void binPutLenPrefixed(Writer &w, const QByteArray &ba) {
+            binPutVarint(w, uint64_t(ba.size()));
+            w.write(ba);
+        }
+
+        /// Binary counterpart of Writer::writeVariant() -- accepts the same QVariant types, with the
+        /// same special cases (null QString -> "", empty QByteArray -> null), and throws Error on
+        /// anything it cannot represent.
+        void binEncode(Writer &w, const QVariant &v)
+        {
+            const auto typ = QMetaType::Type(v.type());
+
+            if (v.isNull()) {
+                if (typ == QMetaType::QString) { // see the comment in writeVariant() for why
+                    w.put(char(BinFmt::String));
+                    binPutVarint(w, 0);
+                } else
+                    w.put(char(BinFmt::Null));
+                return;
+            }
+
+            if (UNLIKELY(!v.isValid()))
+                throw Json::Error("Variant is not valid");
+
+            switch(typ) {
+            case QMetaType::QByteArray: {
+                const auto ba = v.toByteArray();
+                if (ba.isEmpty())
+                    w.put(char(BinFmt::Null)); // empty QByteArray is treated specially in this codebase as `null`
+                else {
+                    w.put(char(BinFmt::Bytes));
+                    binPutLenPrefixed(w, ba);
+                }
+                break;
+            }
+            case QMetaType::QString:
+                w.put(char(BinFmt::String));
+                binPutLenPrefixed(w, v.toString().toUtf8());
+                break;
+            case QMetaType::QStringList: {
+                const auto sl = v.toStringList();
+                w.put(char(BinFmt::Array));
+                binPutVarint(w, uint64_t(sl.size()));
+                for (const auto &s : sl) {
+                    w.put(char(BinFmt::String));
+                    binPutLenPrefixed(w, s.toUtf8());
+                }
+                break;
+            }
+            case QMetaType::QByteArrayList: {
+                const auto bal = v.value<QByteArrayList>();
+                w.put(char(BinFmt::Array));
+                binPutVarint(w, uint64_t(bal.size()));
+                for (const auto &ba : bal)
+                    binEncode(w, ba); // each element gets the QByteArray treatment above (incl. empty -> null)
+                break;
+            }
+            case QMetaType::QVariantList: {
+                const auto vl = v.toList();
+                w.put(char(BinFmt::Array));
+                binPutVarint(w, uint64_t(vl.size()));
+                for (const auto &el : vl)
+                    binEncode(w, el);
+                break;
+            }
+            case QMetaType::QVariantMap: {
+                const auto vm = v.toMap();
+                w.put(char(BinFmt::Object));
+                binPutVarint(w, uint64_t(vm.size()));
+                for (auto it = vm.begin(), e = vm.end(); it != e; ++it) {
+                    binPutLenPrefixed(w, it.key().toUtf8());
+                    binEncode(w, it.value());
+                }
+                break;
+            }
+            case QMetaType::QVariantHash: {
+                const auto vh = v.toHash();
+                w.put(char(BinFmt::ObjectH));
+                binPutVarint(w, uint64_t(vh.size()));
+                for (auto it = vh.begin(), e = vh.end(); it != e; ++it) {
+                    binPutLenPrefixed(w, it.key().toUtf8());
+                    binEncode(w, it.value());
+                }
+                break;
+            }
+            case QMetaType::Bool:
+                w.put(char(v.toBool() ? BinFmt::True : BinFmt::False));
+                break;
+            case QMetaType::Int:
+            case QMetaType::Long:
+            case QMetaType::LongLong: {
+                bool ok;
+                const auto i = v.toLongLong(&ok);
+                if (UNLIKELY(!ok))
+                    throw Json::Error(QString("Unable to serialize int64 for '%1'").arg(v.toString()));
+                w.put(char(BinFmt::Int64));
+                binPutFixed64(w, uint64_t(i));
+                break;
+            }
+            case QMetaType::UInt:
+            case QMetaType::ULong:
+            case QMetaType::ULongLong: {
+                bool ok;
+                const auto u = v.toULongLong(&ok);
+                if (UNLIKELY(!ok))
+                    throw Json::Error(QString("Unable to serialize uint64 for '%1'").arg(v.toString()));
+                w.put(char(BinFmt::UInt64));
+                binPutFixed64(w, u);
+                break;
+            }
+            case QMetaType::Double:
+            case QMetaType::Float: {
+                bool ok;
+                const double d = v.toDouble(&ok);
+                if (UNLIKELY(!ok))
+                    throw Json::Error(QString("Unable to serialize double for '%1'").arg(v.toString()));
+                uint64_t u;
+                static_assert(sizeof(u) == sizeof(d));
+                std::memcpy(&u, &d, sizeof(u)); // IEEE-754 bit pattern, endian-normalized by binPutFixed64
+                w.put(char(BinFmt::Double));
+                binPutFixed64(w, u);
+                break;
+            }
+            default:
+                throw Json::Error(QString("Unsupported type %1 (%2) for '%3'").arg(int(typ)).arg(QMetaType::typeName(typ)).arg(v.toString()));
+            }
+        }
+
+        /// Bounds-checked reader for parseBinary(). Every multi-byte read goes through need(), and
+        /// container/string lengths are sanity-checked against the bytes actually remaining before any
+        /// allocation is sized from them (a hostile blob cannot make us reserve gigabytes up-front).
+        struct BinReader {
+            const char *p;
+            const char * const end;
+            const char * const base; ///< start of the whole blob; only used for the offset in error messages
+            const std::size_t maxDepth;
+
+            [[noreturn]] void fail(const char *what) const {
+                throw Json::ParseError(QString("parseBinary: %1 at offset %2").arg(what).arg(qint64(p - base)));
+            }
+            void need(std::size_t n) const {
+                if (UNLIKELY(std::size_t(end - p) < n))
+                    fail("truncated input");
+            }
+            uint64_t getVarint() {
+                uint64_t v = 0;
+                for (unsigned shift = 0; shift < 64; shift += 7) {
+                    need(1);
+                    const uint8_t b = uint8_t(*p++);
+                    v |= uint64_t(b & 0x7fu) << shift;
+                    if (!(b & 0x80u))
+                        return v;
+                }
+                fail("varint too long");
+            }
+            uint64_t getFixed64() {
+                need(8);
+                uint64_t v = 0;
+                for (int i = 0; i < 8; ++i)
+                    v |= uint64_t(uint8_t(p[i])) << (8 * i);
+                p += 8;
+                return v;
+            }
+            QByteArray getLenPrefixed() {
+                const uint64_t len = getVarint();
+                if (UNLIKELY(len > uint64_t(end - p)))
+                    fail("string length exceeds remaining input");
+                need(std::size_t(len)); // redundant with the above, but keeps the invariant obvious
+                const QByteArray ba(p, int(len)); // deep copy; the blob may not outlive the result
+                p += len;
+                return ba;
+            }
+            QVariant getValue(std::size_t depth) {
+                need(1);
+                const uint8_t tag = uint8_t(*p++);
+                switch (tag) {
+                case BinFmt::Null: return QVariant{};
+                case BinFmt::False: return false;
+                case BinFmt::True: return true;
+                case BinFmt::Int64: return qlonglong(getFixed64());
+                case BinFmt::UInt64: return qulonglong(getFixed64());
+                case BinFmt::Double: {
+                    const uint64_t u = getFixed64();
+                    double d;
+                    std::memcpy(&d, &u, sizeof(d));
+                    return d;
+                }
+                case BinFmt::String: {
+                    const QByteArray utf8 = getLenPrefixed();
+                    return QString::fromUtf8(utf8.constData(), utf8.size());
+                }
+                case BinFmt::Bytes: return getLenPrefixed();
+                case BinFmt::Array: {
+                    if (UNLIKELY(depth >= maxDepth))
+                        fail("exceeded max nesting depth");
+                    const uint64_t n = getVarint();
+                    if (UNLIKELY(n > uint64_t(end - p))) // every element costs >= 1 byte
+                        fail("array count exceeds remaining input");
+                    QVariantList l;
+                    l.reserve(int(n));
+                    for (uint64_t i = 0; i < n; ++i)
+                        l.push_back(getValue(depth + 1));
+                    return l;
+                }
+                case BinFmt::Object:
+                case BinFmt::ObjectH: {
+                    if (UNLIKELY(depth >= maxDepth))
+                        fail("exceeded max nesting depth");
+                    const uint64_t n = getVarint();
+                    if (UNLIKELY(n > uint64_t(end - p))) // every entry costs >= 2 bytes
+                        fail("object count exceeds remaining input");
+                    if (tag == BinFmt::ObjectH) {
+                        QVariantHash h;
+                        h.reserve(int(n));
+                        for (uint64_t i = 0; i < n; ++i) {
+                            const QByteArray key = getLenPrefixed();
+                            h.insert(QString::fromUtf8(key.constData(), key.size()), getValue(depth + 1));
+                        }
+                        return h;
+                    }
+                    QVariantMap m;
+                    for (uint64_t i = 0; i < n; ++i) {
+                        const QByteArray key = getLenPrefixed();
+                        m.insert(QString::fromUtf8(key.constData(), key.size()), getValue(depth + 1));
+                    }
+                    return m;
+                }
+                default:
+                    fail("unknown type tag");
+                }
+            }
+        };
+    } // namespace
+
+    QByteArray toBinary(const QVariant &v)
+    {
+        QByteArray ba; // we do it this way for RVO to work on all compilers
+        Writer writer{ba};
+        ba.reserve(1024);
+        writer.write(BinFmt::Magic, sizeof(BinFmt::Magic));
+        binEncode(writer, v); // this may throw
+        return ba;
+    }
+
+    QVariant parseBinary(const QByteArray &blob, std::size_t maxDepth)
+    {
+        const char *p = blob.constData();
+        const char * const end = p + blob.size();
+        if (UNLIKELY(blob.size() < int(sizeof(BinFmt::Magic))
+                     || 0 != std::memcmp(p, BinFmt::Magic, sizeof(BinFmt::Magic) - 1)))
+            throw ParseError("parseBinary: bad magic (input is not a Json::toBinary blob)");
+        if (UNLIKELY(p[sizeof(BinFmt::Magic) - 1] != BinFmt::Magic[sizeof(BinFmt::Magic) - 1]))
+            throw ParseError(QString("parseBinary: unsupported format version %1").arg(int(p[sizeof(BinFmt::Magic) - 1])));
+        BinReader rd{p + sizeof(BinFmt::Magic), end, p, maxDepth};
+        QVariant ret = rd.getValue(0);
+        if (UNLIKELY(rd.p != end))
+            throw ParseError("parseBinary: trailing garbage after the encoded value");
+        return ret;
+    }
+
+    QVariant parseUtf8(const QByteArray &ba, ParseOption opt, ParserBackend backend, ObjectMode objMode,
+                       std::size_t maxDepth)
+    {
         QVariant ret;
-        if (!detail::parse(ret, ba, backend))
+        if (!detail::parse(ret, ba, backend, objMode, maxDepth))
             throw ParseError(QString("Failed to parse Json from string: %1%2").arg(QString(ba.left(80)))
                              .arg(ba.size() > 80 ? "..." : ""));
-        if (opt == ParseOption::RequireObject && QMetaType::Type(ret.type()) != QMetaType::QVariantMap)
+        const auto objType = objMode == ObjectMode::HashObjects ? QMetaType::QVariantHash : QMetaType::QVariantMap;
+        if (opt == ParseOption::RequireObject && QMetaType::Type(ret.type()) != objType)
             throw Error("Json Error: expected object");
         if (opt == ParseOption::RequireArray && QMetaType::Type(ret.type()) != QMetaType::QVariantList)
             throw Error("Json Error: expected array");
         return ret;
     }
-    QVariant parseFile(const QString &file, ParseOption opt, ParserBackend backend) {
+    QVariant parseFile(const QString &file, ParseOption opt, ParserBackend backend, ObjectMode objMode,
+                       std::size_t maxDepth) {
         QFile f(file);
         if (!f.open(QFile::ReadOnly))
             throw Error(QString("Could not open file: %1").arg(file));
+        const bool compressed = file.endsWith(QLatin1String(".qz"), Qt::CaseInsensitive);
+        const auto dispatch = [&](const QByteArray &ba) {
+            if (compressed) {
+                if (backend == ParserBackend::Default && objMode == ObjectMode::MapObjects && maxDepth == DefaultMaxDepth)
+                    return parseCompressed(ba, opt); // pipelined decompression + parse
+                // non-default options: decompress one-shot so parseUtf8 can honor them
+                const QByteArray plain = qUncompress(ba);
+                if (UNLIKELY(plain.isEmpty()))
+                    throw ParseError(QString("parseFile: could not decompress %1").arg(file));
+                return parseUtf8(plain, opt, backend, objMode, maxDepth);
+            }
+            return parseUtf8(ba, opt, backend, objMode, maxDepth);
+        };
+        // Prefer a zero-copy memory mapping of the file; the parser only ever takes shallow views into
+        // the input buffer, so it can read straight from the page cache without us copying the whole
+        // file into a QByteArray first. Fall back to readAll() if the file cannot be mapped (empty
+        // file, special file, resource fs, etc).
+        if (const qint64 size = f.size(); size > 0 && size <= std::numeric_limits<int>::max()) {
+            if (const uchar * const map = f.map(0, size); map) {
+                // Note: the shallow view below is only valid while `f` is alive (and mapped) -- we
+                // take care here to keep `f` in scope until the parse returns.
+                const QByteArray ba = QByteArray::fromRawData(reinterpret_cast<const char *>(map), int(size));
+                return dispatch(ba);
+            }
+        }
         const QByteArray ba{f.readAll()};
-        return parseUtf8(ba, opt, backend);
+        return dispatch(ba);
+    }
+
+    QVariant parseCompressed(const QByteArray &compressed, ParseOption opt)
+    {
+        constexpr int HeaderSize = 4; // qCompress prefixes the zlib stream with the expected size, big-endian
+        if (UNLIKELY(compressed.size() <= HeaderSize))
+            throw ParseError("parseCompressed: input is too short to be qCompress data");
+#if HAVE_ZLIB
+        z_stream zs;
+        std::memset(&zs, 0, sizeof(zs));
+        if (UNLIKELY(inflateInit(&zs) != Z_OK))
+            throw Error("parseCompressed: inflateInit failed");
+        struct ZGuard { z_stream *zs; ~ZGuard() { inflateEnd(zs); } } const guard{&zs};
+        zs.next_in = const_cast<Bytef *>(reinterpret_cast<const Bytef *>(compressed.constData() + HeaderSize));
+        zs.avail_in = uInt(compressed.size() - HeaderSize);
+        // Pipelined: inflate into a fixed-size window and feed each plaintext chunk straight into the
+        // resumable parser, so only `ChunkSize` bytes of decompressed text ever exist at once (rather
+        // than materializing the entire expanded document the way qUncompress + parseUtf8 would).
+        StreamParser sp;
+        constexpr std::size_t ChunkSize = 256 * 1024;
+        const auto window = std::make_unique<char[]>(ChunkSize);
+        for (;;) {
+            zs.next_out = reinterpret_cast<Bytef *>(window.get());
+            zs.avail_out = uInt(ChunkSize);
+            const int rc = inflate(&zs, Z_NO_FLUSH);
+            if (const std::size_t produced = ChunkSize - zs.avail_out; produced)
+                sp.feed(window.get(), produced); // may throw ParseError as soon as the plaintext is malformed
+            else if (rc == Z_OK && zs.avail_in == 0)
+                throw ParseError("parseCompressed: truncated deflate stream");
+            if (rc == Z_STREAM_END)
+                break;
+            if (UNLIKELY(rc == Z_BUF_ERROR))
+                throw ParseError("parseCompressed: truncated deflate stream");
+            if (UNLIKELY(rc != Z_OK))
+                throw ParseError(QString("parseCompressed: corrupt deflate stream (zlib error %1)").arg(rc));
+        }
+        return sp.result(opt); // behaves like parseUtf8 w.r.t. ParseOption / incomplete documents
+#else
+        // built without JSON_HAS_ZLIB: one-shot decompression, then a regular parse
+        const QByteArray plain = qUncompress(compressed);
+        if (UNLIKELY(plain.isEmpty()))
+            throw ParseError("parseCompressed: qUncompress failed (corrupt or not qCompress data)");
+        return parseUtf8(plain, opt);
+#endif
     }
     QByteArray toUtf8(const QVariant &v, bool compact, SerOption opt) {
         if (opt == SerOption::NoBareNull && v.isNull())
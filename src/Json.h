@@ -27,12 +27,18 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include <QByteArray>
 #include <QString>
+#include <QStringView>
 #include <QVariant>
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <optional>
 #include <stdexcept>
 #include <vector>
 
+class QIODevice;
+
 /// A namespace for a custom JSON parser and serializer that doesn't
 /// suffer from the 128MB limit and heap fragmentation that Qt 5.14.x
 /// and below suffer from, and has none of the bugs that Qt 5.15.0 has.
@@ -69,13 +75,236 @@ namespace Json {
         FastestAvailable  ///< If SimdJson is available, use that, if not, use Default.
     };
 
+    enum class ObjectMode {
+        MapObjects,       ///< JSON objects become QVariantMap (sorted keys) -- the historical default
+        HashObjects       ///< JSON objects become QVariantHash: O(1) inserts & lookups, unordered keys.
+                          ///< Faster for lookup-heavy consumers; note the serializer accepts both, so
+                          ///< round-tripping works either way (hash key order is unspecified, however).
+    };
+
+    /// Default limit on JSON nesting depth; parses exceeding the limit fail with ParseError. 512 follows
+    /// widely-deployed PHP's lead (real-world depth > 32 is already rare). May be raised per-call for
+    /// trusted machine-generated inputs: the parser itself is safe at any depth (its tree construction,
+    /// tree-to-QVariant conversion, and teardown are all iterative), but the *returned* deeply-nested
+    /// QVariant still destructs recursively inside Qt, so very large limits trade ParseError for a
+    /// possible stack overflow when the result is eventually destroyed -- raise with moderation. Note
+    /// the limit applies to the Default backend; the SimdJson backend enforces its own fixed internal
+    /// limit.
+    inline constexpr std::size_t DefaultMaxDepth = 512;
+
     /// If ParseOption is not satisfied, throws Error. May also throw Error on invalid JSON. May throw
     /// ParserUnavailable. Additionally, may throw a std::exception too on low-level error (bad_alloc, etc).
     extern QVariant parseUtf8(const QByteArray &json, ParseOption = ParseOption::AcceptAnyValue,
-                              ParserBackend = ParserBackend::Default);
-    /// Convenience method -- loads all data from file and calls parseUtf8 on it.
+                              ParserBackend = ParserBackend::Default, ObjectMode = ObjectMode::MapObjects,
+                              std::size_t maxDepth = DefaultMaxDepth);
+    /// Convenience method -- parses the file's contents as JSON. The file is memory-mapped and parsed
+    /// in-place (zero-copy) when possible, falling back to reading it all into memory otherwise.
+    /// Files ending in ".qz" are treated as qCompress-compressed JSON and routed through
+    /// parseCompressed() below (when the non-default args are left at their defaults; otherwise the
+    /// file is decompressed one-shot so the requested backend/objMode/maxDepth can be honored).
     extern QVariant parseFile(const QString &file, ParseOption = ParseOption::AcceptAnyValue,
-                              ParserBackend = ParserBackend::Default);
+                              ParserBackend = ParserBackend::Default, ObjectMode = ObjectMode::MapObjects,
+                              std::size_t maxDepth = DefaultMaxDepth);
+    /// Parses JSON stored in qCompress() format (a 4-byte big-endian size prefix followed by a zlib
+    /// stream). When built with JSON_HAS_ZLIB defined (and linked against zlib; see CMakeLists.txt /
+    /// Json.pro), decompression is pipelined with parsing: plaintext is inflated into a fixed-size
+    /// window that is fed straight into a StreamParser, so only that window -- not the entire
+    /// expanded document -- is ever held in memory alongside the compressed input. By default it
+    /// falls back to qUncompress() + parseUtf8(), which adds no link dependency.
+    /// Always uses the Default backend. Throws ParseError on corrupt/truncated compressed data or
+    /// malformed JSON; Error if ParseOption is violated. Implemented in Json.cpp.
+    extern QVariant parseCompressed(const QByteArray &compressed, ParseOption = ParseOption::AcceptAnyValue);
+
+    /// Callback interface for parseEvents() below. Each callback should return true to continue parsing,
+    /// or false to abort the parse early (in which case parseEvents() returns false).
+    ///
+    /// Note: The QByteArrays passed to onKey(), onString() and onNumber() may be *shallow views* into the
+    /// buffer being parsed (see QByteArray::fromRawData). They are only guaranteed valid for the duration
+    /// of the callback -- take a deep copy if you need to keep them around.
+    struct EventHandler {
+        virtual ~EventHandler();
+        virtual bool onObjectStart() = 0;
+        virtual bool onObjectEnd() = 0;
+        virtual bool onArrayStart() = 0;
+        virtual bool onArrayEnd() = 0;
+        /// The next value parsed will be the value for `key` (keys arrive unescaped & UTF-8 processed)
+        virtual bool onKey(const QByteArray &key) = 0;
+        /// String value (unescaped & UTF-8 processed)
+        virtual bool onString(const QByteArray &utf8) = 0;
+        /// Number value; `numStr` is the raw JSON number token e.g. "-1.25e7". No conversion is performed
+        /// here so that consumers that don't care about a particular number pay nothing for it.
+        virtual bool onNumber(const QByteArray &numStr) = 0;
+        virtual bool onBool(bool b) = 0;
+        virtual bool onNull() = 0;
+    };
+
+    /// SAX-style event-driven parse. Drives `handler` directly from the tokenizer with no intermediate
+    /// tree construction -- use this instead of parseUtf8() when you only need to extract a few values
+    /// from a large document and don't want to pay for building the full QVariant tree.
+    /// Implemented in Json_Parser.cpp (always uses the Default backend's tokenizer).
+    /// @returns true if the document was fully parsed, false if a handler callback aborted the parse.
+    /// @throws ParseError on malformed JSON, or std::exception on low-level error (bad_alloc, etc).
+    extern bool parseEvents(const QByteArray &json, EventHandler &handler);
+
+    /// Incremental (chunked/resumable) parser. Feed it data as it arrives off e.g. a socket and it will
+    /// tokenize and build the result as it goes, so parsing overlaps with network I/O and no staging
+    /// buffer holding the full document is needed. Always uses the Default backend's state machine
+    /// (implemented in Json_Parser.cpp). Example:
+    ///
+    ///     Json::StreamParser sp;
+    ///     while (...) sp.feed(chunk);       // may throw ParseError as soon as input is malformed
+    ///     QVariant v = sp.result();         // signals end-of-input; throws if doc is incomplete
+    ///
+    /// Note: malformed input is detected as early as possible, but input that merely *ends* mid-document
+    /// can only be detected when result() is called (since more data could always have followed).
+    class StreamParser {
+    public:
+        StreamParser();
+        ~StreamParser();
+        StreamParser(StreamParser &&) noexcept;
+        StreamParser &operator=(StreamParser &&) noexcept;
+
+        /// Feed the next chunk of input. May throw ParseError if the input so far is definitely
+        /// malformed. Throws Error if called after result() (call reset() first to reuse the object).
+        void feed(const char *data, std::size_t len);
+        void feed(const QByteArray &chunk) { feed(chunk.constData(), std::size_t(chunk.size())); }
+
+        /// Returns true once a complete top-level value has been parsed. Note that for documents whose
+        /// root is a bare number this may remain false until result() is called, since a number token
+        /// at the very end of the fed data could always be continued by a subsequent chunk.
+        bool done() const noexcept;
+
+        /// Signals end-of-input and returns the parsed document (like parseUtf8 does, w.r.t. ParseOption).
+        /// Throws ParseError if the input is incomplete or malformed, Error if ParseOption is violated.
+        /// May be called more than once; subsequent calls return the cached result.
+        QVariant result(ParseOption = ParseOption::AcceptAnyValue);
+
+        /// Clears all state so the object may be reused to parse a new document.
+        void reset();
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> p;
+    };
+
+    /// Reusable parse context for high-rate parsing of many (typically small) documents. A one-shot
+    /// parseUtf8() call pays per-call setup: parse-tree arena and depth-stack construction, full
+    /// teardown, and a fresh object-key cache. A ParseContext keeps all of that alive between calls,
+    /// so steady-state small-document parsing does no allocations beyond the output QVariants:
+    ///
+    ///     Json::ParseContext ctx;
+    ///     for (const auto & body : requests) handle(ctx.parse(body));
+    ///
+    /// Always uses the Default backend (the SimdJson backend already amortizes its own buffers
+    /// internally). Not thread-safe; use one ParseContext per thread. Implemented in Json_Parser.cpp.
+    class ParseContext {
+    public:
+        ParseContext();
+        ~ParseContext();
+        ParseContext(ParseContext &&) noexcept;
+        ParseContext &operator=(ParseContext &&) noexcept;
+
+        /// Parses `json` exactly like parseUtf8() (same result, same exceptions), reusing this
+        /// context's internal buffers.
+        QVariant parse(const QByteArray &json, ParseOption = ParseOption::AcceptAnyValue,
+                       ObjectMode = ObjectMode::MapObjects, std::size_t maxDepth = DefaultMaxDepth);
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> p;
+    };
+
+    /// Parses a newline-delimited JSON buffer (NDJSON / "JSON Lines": one complete JSON document per
+    /// line) and returns the parsed records, in input order. Records are split on '\n' and parsed
+    /// concurrently on a pool of worker threads (each worker running the regular parser for `backend`),
+    /// which scales near-linearly with core count on large corpora. Blank lines are skipped.
+    /// @param maxThreads - number of worker threads to use; <= 0 (the default) means one per hardware
+    ///                     thread. A value of 1 parses everything on the calling thread.
+    /// @throws ParseError if any record is malformed (the message includes its line number). May also
+    ///         throw ParserUnavailable or std::exception, as with parseUtf8(). Implemented in Json_Parser.cpp.
+    extern QVariantList parseLines(const QByteArray &ndjson, ParserBackend = ParserBackend::Default,
+                                   int maxThreads = 0);
+
+    /// Parses a (typically huge) JSON document whose root is an array, splitting the work across a
+    /// pool of worker threads. A fast structural pre-scan locates the boundaries of the top-level
+    /// elements (tracking string/escape state, no tokenizing); workers then run the regular Default
+    /// parser over contiguous runs of elements, and the per-run results are stitched back together in
+    /// input order. Falls back to a plain parseUtf8() -- with identical results and error behavior --
+    /// when the input is small, the root is not an array, or only one thread is available, so this is
+    /// always safe to call. Worth it for multi-hundred-MB array-of-objects corpora, where it scales
+    /// near-linearly with core count.
+    /// @param maxThreads - number of worker threads to use; <= 0 (the default) means one per hardware
+    ///                     thread. A value of 1 parses everything on the calling thread.
+    /// @throws exactly what parseUtf8() throws. Implemented in Json_Parser.cpp.
+    extern QVariant parseUtf8Parallel(const QByteArray &json, ParseOption = ParseOption::AcceptAnyValue,
+                                      ObjectMode = ObjectMode::MapObjects, int maxThreads = 0,
+                                      std::size_t maxDepth = DefaultMaxDepth);
+
+    /// Extracts the single value addressed by an RFC 6901 JSON Pointer (e.g. "/result/tip/height")
+    /// without materializing the rest of the document. The Default backend walks the token stream,
+    /// skipping every subtree that does not lie on the path, and only the matched value is converted
+    /// to a QVariant -- probing one field of a large status document costs a small fraction of a full
+    /// parseUtf8(). The SimdJson backend parses to its internal tape and resolves the pointer there
+    /// (no off-path QVariants are allocated). An empty pointer addresses the whole document. Note
+    /// that the Default backend only validates the bytes it actually walks; malformed content beyond
+    /// the extracted value may go undetected -- use parseUtf8() when full validation matters.
+    /// @throws Error if the pointer is syntactically invalid or no value exists at the path,
+    ///         ParseError on malformed JSON, and possibly ParserUnavailable, as with parseUtf8().
+    ///         Implemented in Json_Parser.cpp.
+    extern QVariant extract(const QByteArray &json, QStringView pointer,
+                            ParserBackend = ParserBackend::Default);
+
+    /// A lazily-materialized document handle backed by the SimdJson backend. Document::parse() runs
+    /// only simdjson's structural parse; no QVariants are created until a value is actually touched,
+    /// so selectively reading a couple of fields out of a huge document avoids materializing the rest:
+    ///
+    ///     auto doc = Json::Document::parse(bytes);
+    ///     qulonglong height = doc["result"]["height"].toVariant().toULongLong();
+    ///
+    /// Indexing operators are cheap cursors that merely accumulate a path; the document is only walked
+    /// (and the target value converted to QVariant) when toVariant() is called. A Document is move-only
+    /// and must outlive any Value cursors obtained from it. Implemented in Json_Parser.cpp.
+    class Document {
+    public:
+        /// Lightweight cursor pointing at a (possibly non-existent) value inside a Document.
+        class Value {
+        public:
+            Value operator[](QStringView key) const;  ///< descend into an object member (lazy, no parse work)
+            Value operator[](int index) const;        ///< descend into an array element (lazy, no parse work)
+            /// True if a value actually exists at this path (walks the document, materializes nothing).
+            bool exists() const;
+            /// Materializes (only) the value at this path. Throws Error if no value exists at this path.
+            QVariant toVariant() const;
+            operator QVariant() const { return toVariant(); }
+        private:
+            friend class Document;
+            Value(const Document *d, QString p) : doc(d), ptr(std::move(p)) {}
+            const Document *doc;
+            QString ptr; ///< accumulated RFC 6901 JSON Pointer
+        };
+
+        Document();  ///< constructs an empty document; all access will throw/fail until assigned from parse()
+        ~Document();
+        Document(Document &&) noexcept;
+        Document &operator=(Document &&) noexcept;
+
+        /// Parses `json`, doing only the structural pass. Throws ParserUnavailable if the SimdJson
+        /// backend is not compiled-in, or ParseError if the document is malformed.
+        static Document parse(const QByteArray &json);
+
+        Value operator[](QStringView key) const { return root()[key]; }
+        Value operator[](int index) const { return root()[index]; }
+        Value root() const { return Value{this, QString{}}; }
+        /// Access by RFC 6901 JSON Pointer, e.g. doc.atPointer("/result/height")
+        Value atPointer(QStringView jsonPointer) const { return Value{this, jsonPointer.toString()}; }
+        /// Materializes the entire document (equivalent to parseUtf8 with the SimdJson backend).
+        QVariant toVariant() const { return root().toVariant(); }
+        bool isValid() const noexcept;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> p;
+    };
 
     enum class SerOption { NoBareNull, BareNullOk };
     /// Serialization, may throw Error, may throw std::exception on low-level error (bad_alloc, etc).
@@ -86,8 +315,111 @@ namespace Json {
 
     /// Low-level function -- like toUtf8() but lets you control the indentation level, etc.
     /// prettyIndent = 0 - compact (no whitespace), otherwise it will be the amount to indent at each level
+    /// sizeHint = 0 - the output buffer is reserved up-front from a fast size-estimation pre-pass over the
+    /// QVariant tree (avoids repeated realloc+memcpy cycles on large documents); pass a non-zero sizeHint
+    /// to skip the pre-pass and reserve exactly that many bytes instead (e.g. the size of the previous
+    /// serialization of a similarly-shaped document).
     /// May throw Error or std::exception, or return an empty QByteArray on error.
-    extern QByteArray serialize(const QVariant &v, unsigned prettyIndent = 0, unsigned indentLevel = 0);
+    extern QByteArray serialize(const QVariant &v, unsigned prettyIndent = 0, unsigned indentLevel = 0,
+                                std::size_t sizeHint = 0);
+
+    /// Like serialize() but streams the output to an open, writable QIODevice (socket, file, etc) in
+    /// fixed-size chunks as the QVariant tree is walked, instead of materializing the whole document in
+    /// one QByteArray first. Memory stays bounded by roughly `chunkSize` (plus the largest single scalar
+    /// value) regardless of document size, and serialization overlaps with the device's writes.
+    /// Throws Error if the device is not writable or a write fails, else may throw like serialize().
+    extern void serializeToDevice(const QVariant &v, QIODevice &device, unsigned prettyIndent = 0,
+                                  unsigned indentLevel = 0, std::size_t chunkSize = 256 * 1024);
+
+    /// Parallel variant of serialize() for large top-level arrays. If `v` is a QVariantList with a few
+    /// hundred elements or more and prettyIndent == 0, array elements are serialized concurrently on a
+    /// pool of worker threads (each into its own buffer, with a final ordered concatenation), which
+    /// scales near-linearly with core count on e.g. array-of-objects mempool dumps. For anything else
+    /// (small arrays, non-arrays, pretty mode) this transparently falls back to plain serialize(), so
+    /// the output is always byte-identical to serialize(v, prettyIndent).
+    /// @param maxThreads - <= 0 (the default) means one worker per hardware thread; 1 forces serial.
+    extern QByteArray serializeParallel(const QVariant &v, unsigned prettyIndent = 0, int maxThreads = 0);
+
+    /// Streaming JSON writer. Emits escaped, correctly-delimited JSON text directly into an internal
+    /// buffer, so callers can stream a document straight from their own data structures without first
+    /// building an intermediate QVariantMap/QVariantList tree for serialize() to walk. Output is
+    /// byte-identical to what serialize(equivalentTree, prettyIndent) would have produced. Example:
+    ///
+    ///     Json::Builder b;
+    ///     {
+    ///         auto o = b.objectScope();                    // RAII: closes the object when destroyed
+    ///         b.key(u"id").value(42);
+    ///         auto a = b.arrayScope();                     // note: key() must precede this in an object
+    ///         for (const auto & r : results) b.value(r);
+    ///     }
+    ///     QByteArray json = b.take();
+    ///
+    /// Misuse (value without a key inside an object, mismatched/unbalanced ends, more than one
+    /// top-level value, etc.) throws Error. Implemented in Json.cpp.
+    class Builder {
+    public:
+        explicit Builder(unsigned prettyIndent = 0);
+        ~Builder();
+        Builder(Builder &&) noexcept;
+        Builder &operator=(Builder &&) noexcept;
+
+        Builder &beginObject();
+        Builder &endObject();
+        Builder &beginArray();
+        Builder &endArray();
+
+        /// Write an object member's key; must be balanced by exactly one value()/begin*() call.
+        Builder &key(QStringView k);
+
+        Builder &value(std::nullptr_t);                                    ///< emits `null`
+        Builder &value(bool b);
+        Builder &value(int i) { return value(qlonglong(i)); }
+        Builder &value(qlonglong i);
+        Builder &value(qulonglong u);
+        Builder &value(double d);
+        Builder &value(QStringView s);
+        Builder &value(const char *utf8) { return value(QStringView{QString::fromUtf8(utf8)}); }
+        Builder &value(const QByteArray &utf8); ///< utf8 string data; empty emits `null` (same convention as serialize())
+        Builder &value(const QVariant &v);      ///< any QVariant, incl. nested containers (walked like serialize())
+
+        /// RAII guard closing a container scope on destruction (or on an explicit end() call).
+        class Scope {
+            friend class Builder;
+            Builder *b = nullptr;
+            bool obj{};
+            Scope(Builder *bb, bool isObj) noexcept : b(bb), obj(isObj) {}
+        public:
+            Scope(Scope &&o) noexcept : b(o.b), obj(o.obj) { o.b = nullptr; }
+            ~Scope() { try { end(); } catch (...) { /* must not throw from a dtor; call end() explicitly to observe errors */ } }
+            void end() { if (auto * const bb = b) { b = nullptr; obj ? bb->endObject() : bb->endArray(); } }
+        };
+        Scope objectScope() { beginObject(); return Scope{this, true}; }
+        Scope arrayScope() { beginArray(); return Scope{this, false}; }
+
+        /// Finalizes and returns the document, resetting the Builder for reuse. Throws Error if
+        /// containers are still open or if no value was ever written.
+        QByteArray take();
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> p;
+    };
+
+    /// Encodes a QVariant tree into a compact binary blob for fast local round-trips (caches, IPC,
+    /// scratch files) -- NOT a wire standard, and the format may change between library versions (the
+    /// blob carries a magic + version header, so a stale cache is detected rather than misparsed).
+    /// Values are encoded as a 1-byte type tag followed by a fixed-width (numbers, little-endian) or
+    /// varint-length-prefixed (strings, containers) payload, so a round-trip skips number formatting,
+    /// string escaping and the whole text tokenizer. The type mapping matches serialize(): the same
+    /// QVariant types are accepted (anything else throws Error), QString vs QByteArray is preserved,
+    /// QVariantMap vs QVariantHash is preserved, and an empty QByteArray maps to null just as it does
+    /// in JSON text. Implemented in Json.cpp.
+    extern QByteArray toBinary(const QVariant &v);
+
+    /// Decodes a blob produced by toBinary(). Every length and tag is bounds-checked; malformed,
+    /// truncated or version-mismatched input throws ParseError. `maxDepth` bounds container nesting
+    /// (and thus the decoder's recursion) exactly like the text parsers. Implemented in Json.cpp.
+    extern QVariant parseBinary(const QByteArray &blob, std::size_t maxDepth = DefaultMaxDepth);
 
 
     // --
@@ -116,16 +448,41 @@ namespace Json {
         extern QString versionString();
     }
 
+    /// Optional hot-path instrumentation counters, maintained per-thread. These are only compiled in
+    /// if the library was built with JSON_ENABLE_STATS defined (CMake option JSON_ENABLE_STATS);
+    /// without it the hot paths pay zero cost and statsSnapshot() always returns all-zero counters.
+    struct Stats {
+        uint64_t bytesParsed{};        ///< bytes consumed by the tokenizer (Default backend)
+        uint64_t tokens{};             ///< tokens produced by the tokenizer (Default backend)
+        uint64_t valuesCreated{};      ///< QVariants materialized from the parse tree (both backends)
+        uint64_t escapeSlowPathHits{}; ///< characters that hit the escape slow path when serializing strings
+        uint64_t arenaSlabAllocs{};    ///< parse-arena slab allocations (i.e. actual mallocs, not bump-allocs)
+        uint64_t parsesDefault{};      ///< parses dispatched to the Default backend
+        uint64_t parsesSimdJson{};     ///< parses dispatched to the SimdJson backend
+    };
+    /// Returns a snapshot of the calling thread's counters (see Stats above). Counters accumulate for
+    /// the lifetime of the thread; use statsReset() to zero them e.g. around a region of interest.
+    extern Stats statsSnapshot() noexcept;
+    /// Zeroes the calling thread's counters. A no-op if built without JSON_ENABLE_STATS.
+    extern void statsReset() noexcept;
+
     /// Call this to check and/or force LC_NUMERIC to use decimal points otherwise parsing/serializing may produce
     /// invalid numeric values (we require "." for the decimal point character).
     ///
+    /// Note: the number kernels used on the hot paths (integer digit-pair formatting, std::to_chars
+    /// float formatting where available, and the fast float parse) are locale-independent by
+    /// construction, so since the removal of the per-call check this only matters for the rare
+    /// fallback paths that still go through the C library (see detail::ensureLocaleChecked()).
+    ///
     /// @param `autoFix` if true, we force the locale if it was incorrect. If false, we do not.
     /// @returns `true` if the locale was ok, `false` if it wasn't (will have been auto-fixed if `autoFix==true`)
     bool checkLocale(bool autoFix = true);
 
-    /// Defaults to true. Set this to false to not check & auto-set the numeric locale on each call to serialize()
-    /// and/or parse*(). Checking the locale on each call takes ~1-10 us at most, but if you want to not waste those
-    /// cycles, this flag is offered for advanced users of this library.
+    /// Defaults to true. Governs what happens when a rare locale-sensitive fallback path is hit (see
+    /// checkLocale() above): if true the locale is checked (and forced if wrong) at that point; if
+    /// false it is checked exactly once, with a warning but no fix. serialize() and parse*() no
+    /// longer pay any per-call locale cost either way, since their hot paths never consult the
+    /// locale at all.
     extern bool autoFixLocale;
 
 
@@ -142,7 +499,30 @@ namespace Json {
         ///               may be parsed.
         /// @param backend - The backend to use.  May throw `ParserUnavailable` if backend is SimdJson and it is not
         ///                  available.
+        /// @param objMode - Whether JSON objects become QVariantMap or QVariantHash in `out`.
+        /// @param maxDepth - Nesting depth beyond which the parse fails (Default backend only).
         /// @returns true on success, false on parse error.
-        extern bool parse(QVariant &out, const QByteArray &json, ParserBackend backend);
+        extern bool parse(QVariant &out, const QByteArray &json, ParserBackend backend,
+                          ObjectMode objMode = ObjectMode::MapObjects,
+                          std::size_t maxDepth = DefaultMaxDepth);
+
+        /// Runs the checkLocale() logic (honoring Json::autoFixLocale) on behalf of the rare code
+        /// paths that still call locale-sensitive C library conversions -- the pre-C++17 snprintf
+        /// double formatter and the exotic-number strtod fallback. The hot paths are
+        /// locale-independent by construction and never call this. Implemented in Json.cpp.
+        extern void ensureLocaleChecked();
+
+#ifdef JSON_ENABLE_STATS
+        /// Thread-local backing store for Json::statsSnapshot(). Internal; defined in Json.cpp.
+        extern thread_local Stats stats;
+#endif
     }
 }
+
+/// Internal helper used by the implementation to bump a Json::Stats counter for the calling thread.
+/// Expands to a no-op when the library is built without JSON_ENABLE_STATS.
+#ifdef JSON_ENABLE_STATS
+#define JSON_STAT_ADD(member, n) (::Json::detail::stats.member += (n))
+#else
+#define JSON_STAT_ADD(member, n) ((void)0)
+#endif
@@ -0,0 +1,382 @@
+/*
+Json - A lightweight JSON parser and serializer for Qt.
+Copyright (c) 2020-2021 Calin A. Culianu <calin.culianu@gmail.com>
+
+The MIT License (MIT)
+
+Permission is hereby granted, free of charge, to any person obtaining
+a copy of this software and associated documentation files (the
+"Software"), to deal in the Software without restriction, including
+without limitation the rights to use, copy, modify, merge, publish,
+distribute, sublicense, and/or sell copies of the Software, and to
+permit persons to whom the Software is furnished to do so, subject to
+the following conditions:
+
+The above copyright notice and this permission notice shall be
+included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE
+LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION
+OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION
+WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+// JsonBench - Statistical benchmark harness for the Json lib.
+//
+// Unlike the quick `Json bench` mode in main.cpp (which just prints wall times), this tool runs
+// warmup iterations, reports median/p99/stddev and MB/s per corpus file, backend, and operation,
+// emits the results as machine-readable JSON, and can diff a run against a saved baseline file with
+// a pass/fail regression threshold -- suitable for catching performance regressions in CI.
+//
+// With --threads N (N > 1) it instead runs each parse/serialize workload concurrently on N threads
+// and reports aggregate and per-thread throughput plus scaling efficiency versus a 1-thread baseline
+// measured the same way -- sublinear scaling (lock or allocator contention) fails the run.
+//
+// Usage: JsonBench [DATADIR] [--iters N] [--warmup N] [--out results.json]
+//                  [--baseline baseline.json] [--threshold PCT]
+//                  [--threads N] [--min-scaling PCT]
+
+#include "Json.h"
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QIODevice>
+#include <QString>
+#include <QStringList>
+#include <QtDebug>
+#include <QTextStream>
+#include <QVariant>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+class Log
+{
+    QString str = "";
+    QTextStream s = QTextStream(&str, QIODevice::WriteOnly);
+public:
+    ~Log() { std::cout << str.toUtf8().constData() << std::endl; }
+    template <class T> Log & operator<<(const T & t) { s << t; return *this;  }
+};
+
+struct BadArgs : Json::Error {
+    using Json::Error::Error;
+    ~BadArgs() override {}
+};
+using Exception = Json::Error; // alias
+
+double getTimeSecs() {
+    static const auto t0 = std::chrono::high_resolution_clock::now();
+    const auto now = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(now - t0).count() / 1e6;
+}
+
+struct Stats {
+    double medianMsec{}, p99Msec{}, stddevMsec{}, mbPerSec{};
+};
+
+/// Compute summary stats from per-iteration times (in seconds). `bytes` is the size of the
+/// input (for parse) or output (for serialize), used for the MB/s figure.
+Stats computeStats(std::vector<double> samples, std::size_t bytes)
+{
+    Stats ret;
+    if (samples.empty()) return ret;
+    std::sort(samples.begin(), samples.end());
+    const std::size_t n = samples.size();
+    ret.medianMsec = (n % 2 ? samples[n/2] : (samples[n/2 - 1] + samples[n/2]) / 2.0) * 1e3;
+    ret.p99Msec = samples[std::min(n - 1, std::size_t(std::ceil(n * 0.99)) - 1)] * 1e3;
+    double mean = 0.0;
+    for (const double s : samples) mean += s;
+    mean /= n;
+    double var = 0.0;
+    for (const double s : samples) var += (s - mean) * (s - mean);
+    ret.stddevMsec = std::sqrt(var / n) * 1e3;
+    ret.mbPerSec = ret.medianMsec > 0.0 ? (bytes / 1e6) / (ret.medianMsec / 1e3) : 0.0;
+    return ret;
+}
+
+/// Run `fn` for `warmup` untimed then `iters` timed iterations; returns stats over the timed runs.
+template <typename Fn>
+Stats benchOne(unsigned iters, unsigned warmup, std::size_t bytes, const Fn &fn)
+{
+    for (unsigned i = 0; i < warmup; ++i) fn();
+    std::vector<double> samples;
+    samples.reserve(iters);
+    for (unsigned i = 0; i < iters; ++i) {
+        const double t0 = getTimeSecs();
+        fn();
+        samples.push_back(getTimeSecs() - t0);
+    }
+    return computeStats(std::move(samples), bytes);
+}
+
+/// Result of one concurrent scaling measurement (see benchThreads).
+struct ThreadStats {
+    double aggregateMbPerSec{}, perThreadMbPerSec{}, baselineMbPerSec{}, scalingPct{};
+};
+
+/// Runs `makeFn()`-produced closures concurrently on `nThreads` threads (each thread gets its own
+/// closure, so per-thread state such as a parsed tree is not implicitly shared across threads), with
+/// every thread executing `iters` timed iterations after a synchronized start. Throughput is computed
+/// from the wall time of the whole concurrent run, so any serialization on locks or the allocator
+/// shows up directly. Scaling is per-thread throughput as a percentage of a 1-thread baseline
+/// measured the same way: 100% is perfect scaling, lower is contention (or hyperthread sharing).
+/// The calling thread participates as one of the workers.
+template <typename MakeFn>
+ThreadStats benchThreads(const unsigned nThreads, const unsigned iters, const unsigned warmup,
+                         const std::size_t bytes, const MakeFn &makeFn)
+{
+    ThreadStats ret;
+    {
+        // 1-thread baseline: wall time over `iters` runs, same accounting as the concurrent run below
+        auto fn = makeFn();
+        for (unsigned i = 0; i < warmup; ++i) fn();
+        const double t0 = getTimeSecs();
+        for (unsigned i = 0; i < iters; ++i) fn();
+        const double secs = getTimeSecs() - t0;
+        ret.baselineMbPerSec = secs > 0.0 ? (bytes * double(iters)) / 1e6 / secs : 0.0;
+    }
+    std::atomic<unsigned> nReady{0u};
+    std::atomic<bool> go{false};
+    auto worker = [&](auto fn) {
+        for (unsigned i = 0; i < warmup; ++i) fn();
+        ++nReady;
+        while (!go.load(std::memory_order_acquire)) { /* spin so all threads start together */ }
+        for (unsigned i = 0; i < iters; ++i) fn();
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(nThreads - 1);
+    for (unsigned t = 0; t + 1 < nThreads; ++t) threads.emplace_back(worker, makeFn());
+    auto myFn = makeFn();
+    for (unsigned i = 0; i < warmup; ++i) myFn();
+    ++nReady;
+    while (nReady.load() < nThreads) {} // wait for peers to finish warmup
+    const double t0 = getTimeSecs();
+    go.store(true, std::memory_order_release);
+    for (unsigned i = 0; i < iters; ++i) myFn();
+    for (auto & thr : threads) thr.join(); // the run ends when the slowest thread finishes
+    const double secs = getTimeSecs() - t0;
+    ret.aggregateMbPerSec = secs > 0.0 ? (bytes * double(iters) * nThreads) / 1e6 / secs : 0.0;
+    ret.perThreadMbPerSec = ret.aggregateMbPerSec / nThreads;
+    ret.scalingPct = ret.baselineMbPerSec > 0.0 ? ret.perThreadMbPerSec / ret.baselineMbPerSec * 100.0 : 0.0;
+    return ret;
+}
+
+std::vector<std::pair<QString, QByteArray>> loadCorpus(const QString &dir)
+{
+    QDir dataDir(dir);
+    if (!dataDir.exists()) throw BadArgs(QString("Bench data directory '%1' does not exist").arg(dir));
+    const QStringList nameFilters{{"*.json", "*.json.qz"}};
+    const auto files = dataDir.entryList(nameFilters, QDir::Filter::Files);
+    if (files.isEmpty()) throw BadArgs(QString("Bench data directory '%1' does not have any *.json files").arg(dir));
+    std::vector<std::pair<QString, QByteArray>> ret;
+    for (const auto & fn : files) {
+        QFile f(dataDir.path() + QDir::separator() + fn);
+        if (!f.open(QFile::ReadOnly))
+            throw Exception(QString("Cannot open %1").arg(f.fileName()));
+        QByteArray data = f.readAll();
+        if (fn.endsWith(".qz")) {
+            data = qUncompress(data);
+            if (data.isEmpty())
+                throw Exception(QString("Unable to uncompress: %1").arg(fn));
+        }
+        ret.emplace_back(fn, std::move(data));
+    }
+    return ret;
+}
+
+QString rowKey(const QVariantMap &row) {
+    return QString("%1|%2|%3|%4").arg(row.value("file").toString(), row.value("op").toString(),
+                                      row.value("backend").toString(), row.value("mode").toString());
+}
+
+/// Compare this run's rows against a saved baseline; returns the number of regressions beyond
+/// `thresholdPct` (percent slowdown of the median).
+int diffBaseline(const QVariantList &rows, const QString &baselineFile, double thresholdPct)
+{
+    const auto baseVar = Json::parseFile(baselineFile, Json::ParseOption::RequireObject);
+    QVariantMap baseRows;
+    for (const auto & rv : baseVar.toMap().value("results").toList()) {
+        const auto row = rv.toMap();
+        baseRows[rowKey(row)] = row;
+    }
+    int regressions = 0;
+    Log() << "--- Baseline diff vs " << baselineFile << " (threshold: " << thresholdPct << "%) ---";
+    for (const auto & rv : rows) {
+        const auto row = rv.toMap();
+        const auto key = rowKey(row);
+        if (!baseRows.contains(key)) {
+            Log() << key << ": not in baseline (skipped)";
+            continue;
+        }
+        const double oldMed = baseRows[key].toMap().value("median_msec").toDouble();
+        const double newMed = row.value("median_msec").toDouble();
+        if (oldMed <= 0.0) continue;
+        const double pct = (newMed - oldMed) / oldMed * 100.0;
+        const bool bad = pct > thresholdPct;
+        if (bad) ++regressions;
+        Log() << key << ": " << QString::asprintf("%.3f -> %.3f msec (%+.1f%%)", oldMed, newMed, pct)
+              << (bad ? "  REGRESSION" : "");
+    }
+    return regressions;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    try {
+        QString dataDir = "bench", outFile, baselineFile;
+        unsigned iters = 20, warmup = 3, nThreads = 1;
+        double thresholdPct = 10.0, minScalingPct = 70.0;
+        for (int i = 1; i < argc; ++i) {
+            const QString arg = QString::fromUtf8(argv[i]);
+            auto nextArg = [&]() -> QString {
+                if (++i >= argc) throw BadArgs(QString("Missing value for %1").arg(arg));
+                return QString::fromUtf8(argv[i]);
+            };
+            if (arg == "--iters") iters = nextArg().toUInt();
+            else if (arg == "--warmup") warmup = nextArg().toUInt();
+            else if (arg == "--out") outFile = nextArg();
+            else if (arg == "--baseline") baselineFile = nextArg();
+            else if (arg == "--threshold") thresholdPct = nextArg().toDouble();
+            else if (arg == "--threads") nThreads = nextArg().toUInt();
+            else if (arg == "--min-scaling") minScalingPct = nextArg().toDouble();
+            else if (!arg.startsWith("--")) dataDir = arg;
+            else throw BadArgs(QString("Unknown option: %1").arg(arg));
+        }
+        if (!iters) throw BadArgs("--iters must be a positive integer");
+        if (!nThreads) throw BadArgs("--threads must be a positive integer");
+        if (nThreads > 1 && !baselineFile.isEmpty())
+            throw BadArgs("--baseline cannot be combined with --threads N > 1: thread-mode rows have"
+                          " no median_msec to diff (the scaling gate is --min-scaling instead)");
+
+        using namespace Json;
+        const auto corpus = loadCorpus(dataDir);
+        std::vector<ParserBackend> backends{ParserBackend::Default};
+        if (isParserAvailable(ParserBackend::SimdJson)) backends.push_back(ParserBackend::SimdJson);
+
+        QVariantList rows;
+        auto addRow = [&rows, iters](const QString &file, const char *op, const char *backend,
+                                     const char *mode, const Stats &st) {
+            rows.push_back(QVariantMap{
+                {"file", file}, {"op", op}, {"backend", backend}, {"mode", mode},
+                {"iters", iters}, {"median_msec", st.medianMsec}, {"p99_msec", st.p99Msec},
+                {"stddev_msec", st.stddevMsec}, {"mb_per_sec", st.mbPerSec},
+            });
+            Log() << file << " " << op << "/" << backend << "/" << mode << ": "
+                  << QString::asprintf("median %.3f msec, p99 %.3f msec, stddev %.3f msec, %.1f MB/s",
+                                       st.medianMsec, st.p99Msec, st.stddevMsec, st.mbPerSec);
+        };
+
+        int sublinear = 0;
+        auto addThreadRow = [&rows, &sublinear, iters, nThreads, minScalingPct](
+                                const QString &file, const char *op, const char *backend,
+                                const char *mode, const ThreadStats &ts) {
+            const bool flagged = ts.scalingPct < minScalingPct;
+            if (flagged) ++sublinear;
+            rows.push_back(QVariantMap{
+                {"file", file}, {"op", op}, {"backend", backend}, {"mode", mode},
+                {"iters", iters}, {"threads", nThreads},
+                {"aggregate_mb_per_sec", ts.aggregateMbPerSec},
+                {"per_thread_mb_per_sec", ts.perThreadMbPerSec},
+                {"baseline_mb_per_sec", ts.baselineMbPerSec}, {"scaling_pct", ts.scalingPct},
+            });
+            Log() << file << " " << op << "/" << backend << "/" << mode << ": "
+                  << QString::asprintf("%u threads: %.1f MB/s aggregate (%.1f MB/s per thread),"
+                                       " 1-thread %.1f MB/s, scaling %.1f%%",
+                                       nThreads, ts.aggregateMbPerSec, ts.perThreadMbPerSec,
+                                       ts.baselineMbPerSec, ts.scalingPct)
+                  << (flagged ? "  SUBLINEAR" : "");
+        };
+
+        for (const auto & [fn, data] : corpus) {
+            if (nThreads > 1) {
+                for (const auto backend : backends) {
+                    const char * const bname = backend == ParserBackend::SimdJson ? "simdjson" : "default";
+                    const auto ts = benchThreads(nThreads, iters, warmup, data.size(), [&]{
+                        return [&data, backend]{ (void)parseUtf8(data, ParseOption::AcceptAnyValue, backend); };
+                    });
+                    addThreadRow(fn, "parse", bname, "-", ts);
+                }
+                for (const unsigned prettyIndent : {0u, 4u}) {
+                    const std::size_t outBytes = serialize(parseUtf8(data), prettyIndent).size();
+                    const auto ts = benchThreads(nThreads, iters, warmup, outBytes, [&]{
+                        // each closure parses its own tree so threads serialize independent documents
+                        return [tree = parseUtf8(data), prettyIndent]{ (void)serialize(tree, prettyIndent); };
+                    });
+                    addThreadRow(fn, "serialize", "default", prettyIndent ? "pretty" : "compact", ts);
+                }
+                continue;
+            }
+            QVariant parsed;
+            for (const auto backend : backends) {
+                const char * const bname = backend == ParserBackend::SimdJson ? "simdjson" : "default";
+                const auto st = benchOne(iters, warmup, data.size(), [&]{
+                    parsed = parseUtf8(data, ParseOption::AcceptAnyValue, backend);
+                });
+                addRow(fn, "parse", bname, "-", st);
+            }
+            for (const unsigned prettyIndent : {0u, 4u}) {
+                QByteArray out;
+                const auto st = benchOne(iters, warmup, serialize(parsed, prettyIndent).size(), [&]{
+                    out = serialize(parsed, prettyIndent);
+                });
+                addRow(fn, "serialize", "default", prettyIndent ? "pretty" : "compact", st);
+            }
+        }
+
+        const QVariantMap results{
+            {"meta", QVariantMap{
+                {"date", QDateTime::currentDateTime().toString(Qt::ISODate)},
+                {"datadir", dataDir}, {"iters", iters}, {"warmup", warmup}, {"threads", nThreads},
+            }},
+            {"results", rows},
+        };
+        const QByteArray resultsJson = serialize(results, 4);
+        if (!outFile.isEmpty()) {
+            QFile f(outFile);
+            if (!f.open(QFile::WriteOnly | QFile::Truncate) || f.write(resultsJson) != resultsJson.size())
+                throw Exception(QString("Could not write results to %1").arg(outFile));
+            Log() << "Results written to " << outFile;
+        } else {
+            std::cout << resultsJson.constData() << std::endl;
+        }
+
+        if (!baselineFile.isEmpty()) {
+            const int regressions = diffBaseline(rows, baselineFile, thresholdPct);
+            if (regressions) {
+                Log() << "FAIL: " << regressions << " benchmark(s) regressed beyond " << thresholdPct << "%";
+                return 1;
+            }
+            Log() << "PASS: no regressions beyond " << thresholdPct << "%";
+        }
+        if (nThreads > 1) {
+            if (sublinear) {
+                Log() << "FAIL: " << sublinear << " workload(s) scaled below " << minScalingPct
+                      << "% efficiency at " << nThreads << " threads (lock or allocator contention?)";
+                return 1;
+            }
+            Log() << "PASS: all workloads scaled at or above " << minScalingPct << "% efficiency at "
+                  << nThreads << " threads";
+        }
+        return 0;
+    } catch (const std::exception &e) {
+        qCritical() << "Caught exception:" << e.what();
+        return 1;
+    }
+}
@@ -25,22 +25,35 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 #include "Json.h"
 
+#include <QHash>
 #include <QMetaType>
 #include <QtDebug>
 #include <QVariant>
+#include <QVariantHash>
 #include <QVariantList>
 #include <QVariantMap>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <cerrno>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <utility>
 #include <vector>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 #ifdef __clang__
 // turn off the dreaded "warning: class padded with xx bytes, etc" since we aren't writing wire protocols using structs..
 #pragma clang diagnostic ignored "-Wpadded"
@@ -126,7 +139,7 @@ inline bool json_isspace(uint8_t ch) noexcept {
  * so we will follow PHP's lead, which should be more than sufficient
  * (further stackexchange comments indicate depth > 32 rarely occurs).
  */
-inline constexpr size_t MAX_JSON_DEPTH = 512;
+inline constexpr size_t MAX_JSON_DEPTH = Json::DefaultMaxDepth; // callers may override per-parse, see ParserState::maxDepth
 
 inline bool json_isdigit(uint8_t ch) noexcept { return ch >= '0' && ch <= '9'; }
 
@@ -155,6 +168,80 @@ const char *hextouint(const char *first, const char *last, uint32_t &out) noexce
     return first;
 }
 
+/// Returns a pointer to the first byte in [p, end) that needs special handling inside a JSON string
+/// token: the closing quote, a backslash, a control char (< 0x20), or a non-ascii byte (>= 0x80,
+/// i.e. part of a multi-byte UTF-8 sequence). Bytes before the returned pointer form a clean ascii
+/// run that may be accepted into the output wholesale. Vectorized where possible; note that bytes
+/// >= 0x80 are negative when viewed as signed, so a single signed "< 0x20" compare catches both the
+/// control chars and the non-ascii range.
+const char *findSpecialStringChar(const char *p, const char * const end) noexcept
+{
+#if defined(__SSE2__)
+    const __m128i space = _mm_set1_epi8(0x20);
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i slash = _mm_set1_epi8('\\');
+    for (; end - p >= 16; p += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        __m128i m = _mm_cmplt_epi8(v, space); // signed compare: catches < 0x20 as well as >= 0x80
+        m = _mm_or_si128(m, _mm_cmpeq_epi8(v, quote));
+        m = _mm_or_si128(m, _mm_cmpeq_epi8(v, slash));
+        if (_mm_movemask_epi8(m))
+            break; // some byte in this block is special; the scalar loop below pinpoints it
+    }
+#elif defined(__aarch64__)
+    for (; end - p >= 16; p += 16) {
+        const int8x16_t v = vreinterpretq_s8_u8(vld1q_u8(reinterpret_cast<const uint8_t *>(p)));
+        uint8x16_t m = vcltq_s8(v, vdupq_n_s8(0x20)); // signed compare: catches < 0x20 as well as >= 0x80
+        m = vorrq_u8(m, vceqq_s8(v, vdupq_n_s8('"')));
+        m = vorrq_u8(m, vceqq_s8(v, vdupq_n_s8('\\')));
+        if (vmaxvq_u8(m))
+            break; // some byte in this block is special; the scalar loop below pinpoints it
+    }
+#endif
+    while (p < end && uint8_t(*p) >= 0x20 && uint8_t(*p) < 0x80 && *p != '"' && *p != '\\')
+        ++p;
+    return p;
+}
+
+/// Returns a pointer to the first non-whitespace byte in [p, end). Pretty-printed input spends a
+/// large share of tokenization advancing over indentation, so runs are consumed in 16-byte blocks
+/// where possible (a block is skipped iff every byte matches one of the four JSON whitespace chars);
+/// the scalar loop pinpoints the boundary. Compact input short-circuits on the first byte.
+const char *skipWhitespace(const char *p, const char * const end) noexcept
+{
+    // overwhelmingly common case for compact documents: no whitespace at all before the next token
+    if (p < end && !json_isspace(uint8_t(*p)))
+        return p;
+#if defined(__SSE2__)
+    const __m128i sp = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i nl = _mm_set1_epi8('\n');
+    const __m128i cr = _mm_set1_epi8('\r');
+    for (; end - p >= 16; p += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        __m128i m = _mm_cmpeq_epi8(v, sp);
+        m = _mm_or_si128(m, _mm_cmpeq_epi8(v, tab));
+        m = _mm_or_si128(m, _mm_cmpeq_epi8(v, nl));
+        m = _mm_or_si128(m, _mm_cmpeq_epi8(v, cr));
+        if (_mm_movemask_epi8(m) != 0xffff)
+            break; // block holds a non-whitespace byte; the scalar loop below pinpoints it
+    }
+#elif defined(__aarch64__)
+    for (; end - p >= 16; p += 16) {
+        const uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t *>(p));
+        uint8x16_t m = vceqq_u8(v, vdupq_n_u8(' '));
+        m = vorrq_u8(m, vceqq_u8(v, vdupq_n_u8('\t')));
+        m = vorrq_u8(m, vceqq_u8(v, vdupq_n_u8('\n')));
+        m = vorrq_u8(m, vceqq_u8(v, vdupq_n_u8('\r')));
+        if (vminvq_u8(m) == 0)
+            break; // block holds a non-whitespace byte; the scalar loop below pinpoints it
+    }
+#endif
+    while (p < end && json_isspace(uint8_t(*p)))
+        ++p;
+    return p;
+}
+
 /**
  * Filter that generates and validates UTF-8, as well as collates UTF-16
  * surrogate pairs as specified in RFC4627.
@@ -218,6 +305,10 @@ public:
                 append_codepoint(cp);
         }
     }
+    // True if not mid-way through a multi-byte UTF-8 sequence. In this state whole pre-validated
+    // ascii runs may be appended to the output directly, bypassing the per-byte machine (any open
+    // surrogate pair is still caught by finalize(), same as with per-byte ascii writes).
+    bool clean() const noexcept { return state == 0; }
     // Check that we're in a state where the string can be ended
     // No open sequences, no open surrogate pairs, etc
     bool finalize() noexcept
@@ -266,14 +357,14 @@ private:
 };
 
 /// ** Note ** this may end up making `tokenVal` be a *shallow copy* that points into `raw`
-jtokentype getJsonToken(QByteArray &tokenVal, unsigned &consumed, const char *raw, const char * const end)
+/// (callers should use the getJsonToken() wrapper below, which also maintains the optional stats counters)
+jtokentype getJsonTokenImpl(QByteArray &tokenVal, unsigned &consumed, const char *raw, const char * const end)
 {
     consumed = 0;
 
     const char * const rawStart = raw;
 
-    while (raw < end && (json_isspace(*raw)))          // skip whitespace
-        ++raw;
+    raw = skipWhitespace(raw, end); // vectorized; pretty-printed input is mostly indentation
 
     if (raw >= end)
         return JTOK_NONE;
@@ -307,21 +398,21 @@ jtokentype getJsonToken(QByteArray &tokenVal, unsigned &consumed, const char *ra
         return JTOK_COMMA;
 
     case 'n':
-        if (0 == std::strncmp(raw, "null", 4)) {
+        if (end - raw >= 4 && 0 == std::strncmp(raw, "null", 4)) {
             raw += 4;
             consumed = raw - rawStart;
             return JTOK_KW_NULL;
         }
         return JTOK_ERR;
     case 't':
-        if (0 == std::strncmp(raw, "true", 4)) {
+        if (end - raw >= 4 && 0 == std::strncmp(raw, "true", 4)) {
             raw += 4;
             consumed = raw - rawStart;
             return JTOK_KW_TRUE;
         }
         return JTOK_ERR;
     case 'f':
-        if (0 == std::strncmp(raw, "false", 5)) {
+        if (end - raw >= 5 && 0 == std::strncmp(raw, "false", 5)) {
             raw += 5;
             consumed = raw - rawStart;
             return JTOK_KW_FALSE;
@@ -345,7 +436,7 @@ jtokentype getJsonToken(QByteArray &tokenVal, unsigned &consumed, const char *ra
 
         const char * const firstDigit = first + firstIsMinus; // if first == '-', firstDigit = first + 1, else firstDigit = first
 
-        if (UNLIKELY(*firstDigit == '0' && firstDigit + 1 < end && json_isdigit(firstDigit[1])))
+        if (UNLIKELY(firstDigit < end && *firstDigit == '0' && firstDigit + 1 < end && json_isdigit(firstDigit[1])))
             return JTOK_ERR;
 
         ++raw;                                  // consume first char
@@ -404,24 +495,18 @@ jtokentype getJsonToken(QByteArray &tokenVal, unsigned &consumed, const char *ra
             };
 
             static const auto FastPathParseSimpleString = [](const char *& raw, const char * const end) -> FastPath {
-                for (; raw < end; ++raw) {
-                    const uint8_t ch = uint8_t(*raw);
-                    if (ch == '"') {
-                        // fast-path accept case: simple string end at " char
-                        return FastPath::Processed;
-                    } else if (ch == '\\') {
-                        // has escapes -- cannot process as simple string, must continue using slow path
-                        return FastPath::NotFullyProcessed;
-                    } else if (ch < 0x20) {
-                        // is not legal JSON because < 0x20
-                        return FastPath::Error;
-                    } else if (ch >= 0x80) {
-                        // has a funky unicode character.. must take slow path
-                        return FastPath::NotFullyProcessed;
-                    }
-                }
-                // premature string end
-                return FastPath::Error;
+                // Bulk-scan (SIMD where possible) to the first byte that ends the simple-string run,
+                // then classify that single byte. Strings are the bulk of most real-world inputs, so
+                // this scan bounds whole-parse throughput.
+                raw = findSpecialStringChar(raw, end);
+                if (raw >= end)
+                    return FastPath::Error;               // premature string end
+                const uint8_t ch = uint8_t(*raw);
+                if (ch == '"')
+                    return FastPath::Processed;           // fast-path accept case: simple string end at " char
+                if (ch == '\\' || ch >= 0x80)
+                    return FastPath::NotFullyProcessed;   // escapes or non-ascii -- must continue via slow path
+                return FastPath::Error;                   // is not legal JSON because < 0x20
             };
             switch (const auto begin = raw; FastPathParseSimpleString(raw /*pass-by-ref*/, end)) {
             case FastPath::Processed:
@@ -492,6 +577,14 @@ jtokentype getJsonToken(QByteArray &tokenVal, unsigned &consumed, const char *ra
                 break;                        // stop scanning
             }
 
+            else if (uint8_t(*raw) < 0x80 && LIKELY(writer.clean())) {
+                // Bulk-accept the clean ascii run (>= 1 byte, since *raw itself qualifies) up to the
+                // next escape, quote, control char, or multi-byte UTF-8 boundary in one block copy.
+                const char * const runEnd = findSpecialStringChar(raw, end);
+                tokenVal.append(raw, int(runEnd - raw));
+                raw = runEnd;
+            }
+
             else {
                 writer.push_back(*raw);
                 ++raw;
@@ -514,6 +607,104 @@ jtokentype getJsonToken(QByteArray &tokenVal, unsigned &consumed, const char *ra
     }
 }
 
+/// Thin wrapper over the tokenizer proper; gives the optional JSON_ENABLE_STATS counters a single
+/// spot to observe every token without touching the many return paths above. Compiles down to a plain
+/// call to getJsonTokenImpl() when stats are disabled (the default).
+inline jtokentype getJsonToken(QByteArray &tokenVal, unsigned &consumed, const char *raw, const char * const end)
+{
+    const jtokentype tok = getJsonTokenImpl(tokenVal, consumed, raw, end);
+    JSON_STAT_ADD(bytesParsed, consumed);
+    if (tok != JTOK_NONE && tok != JTOK_ERR)
+        JSON_STAT_ADD(tokens, 1);
+    return tok;
+}
+
+/// Bump allocator owned by one parse (see ParserState below). The Container tree's `values`/`entries`
+/// vectors allocate out of contiguous slabs obtained from here and never free individually -- the whole
+/// arena is released (or rewound for reuse) once the tree has been converted via Container::takeVariant().
+/// This turns the millions of small ephemeral mallocs a large parse used to do into a handful of slab
+/// allocations, and keeps the tree walk cache-friendly.
+class Arena {
+    struct Slab {
+        std::unique_ptr<char[]> mem;
+        size_t size{};
+    };
+    std::vector<Slab> slabs;
+    size_t cur = 0;          ///< index of the slab we are currently bumping into
+    char *ptr = nullptr;     ///< next free byte in the current slab
+    char *slabEnd = nullptr; ///< one-past-the-end of the current slab
+
+    static constexpr size_t InitialSlabSize = 64 * 1024;
+    static constexpr size_t MaxSlabSize = 8 * 1024 * 1024;
+
+    void *allocSlow(size_t bytes, size_t align) {
+        // try to advance into an already-allocated slab first (they survive reset() for reuse)
+        while (cur + 1 < slabs.size()) {
+            ++cur;
+            ptr = slabs[cur].mem.get();
+            slabEnd = ptr + slabs[cur].size;
+            if (void * const ret = tryAlloc(bytes, align))
+                return ret;
+        }
+        size_t newSize = slabs.empty() ? InitialSlabSize : std::min(slabs.back().size * 2, MaxSlabSize);
+        newSize = std::max(newSize, bytes + align);
+        JSON_STAT_ADD(arenaSlabAllocs, 1);
+        slabs.push_back(Slab{std::unique_ptr<char[]>(new char[newSize]), newSize});
+        cur = slabs.size() - 1;
+        ptr = slabs[cur].mem.get();
+        slabEnd = ptr + newSize;
+        return tryAlloc(bytes, align); // cannot fail -- slab was sized to fit
+    }
+
+    void *tryAlloc(size_t bytes, size_t align) noexcept {
+        const uintptr_t aligned = (reinterpret_cast<uintptr_t>(ptr) + (align - 1)) & ~uintptr_t(align - 1);
+        if (ptr && aligned + bytes <= reinterpret_cast<uintptr_t>(slabEnd)) {
+            ptr = reinterpret_cast<char *>(aligned + bytes);
+            return reinterpret_cast<void *>(aligned);
+        }
+        return nullptr;
+    }
+
+public:
+    void *alloc(size_t bytes, size_t align) {
+        if (void * const ret = tryAlloc(bytes, align))
+            return ret;
+        return allocSlow(bytes, align);
+    }
+
+    /// Rewinds the arena so its slabs may be reused for another parse. Caller must ensure nothing
+    /// still references arena memory (i.e. the Container tree has been destroyed first).
+    void reset() noexcept {
+        cur = 0;
+        if (!slabs.empty()) {
+            ptr = slabs.front().mem.get();
+            slabEnd = ptr + slabs.front().size;
+        }
+    }
+};
+
+/// Minimal stateful C++17 allocator fronting an Arena. deallocate() is a no-op -- memory is reclaimed
+/// wholesale when the owning Arena is reset or destroyed.
+template <typename T>
+struct ArenaAllocator {
+    using value_type = T;
+    // all instances for one parse share one arena, so letting containers adopt the source's allocator
+    // on move keeps moves trivially cheap and noexcept
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    Arena *arena;
+
+    explicit ArenaAllocator(Arena *a) noexcept : arena(a) {}
+    template <typename U> ArenaAllocator(const ArenaAllocator<U> &o) noexcept : arena(o.arena) {}
+
+    T *allocate(size_t n) { return static_cast<T *>(arena->alloc(n * sizeof(T), alignof(T))); }
+    void deallocate(T *, size_t) noexcept {}
+
+    bool operator==(const ArenaAllocator &o) const noexcept { return arena == o.arena; }
+    bool operator!=(const ArenaAllocator &o) const noexcept { return arena != o.arena; }
+};
+
 /// Note: The QByteArrays in this struct may be "views of" or shallow copies of the original `bytes` buffer
 /// being parsed (e.g. via QByteArray::fromRawData) -- so when producing the final result we need to always
 /// take deep copies of any QByteArray data.
@@ -525,30 +716,160 @@ struct Container {
     // Note: I tried using a union class here to conserve memory but that was actually 10-20% slower
     // than simply doing this, and had lots of boilerplate for copy/move c'tor and copy/move assign, so
     // we just go with this.  This consumes ~48 bytes of extra memory on avg. per parsed json value;
-    // but since this data structure is ephemeral and only used during parsing, that's acceptable since
-    // the memory will be freed once parsing finishes.  It would only be a problem if we anticipated
-    // parsing json that ends up containing hundreds of millions of json values, but since we don't,
-    // this is fine.
+    // but since this data structure is ephemeral and only used during parsing, that's acceptable. The
+    // child storage below comes out of the per-parse Arena (bump-allocated slabs, freed wholesale once
+    // takeVariant() finishes), so even hundreds of millions of parsed values won't fragment the heap.
     //
     // We could have also used a std::variant here but that is not implemented yet on all compilers
     // that we target.
     QByteArray data; // only for Num, Str -- may be a shallow copy pointing into the `bytes` QByteArray passed to Json::detail::parse()
-    std::vector<Container> values; // only for Arr
-    // Note that the below pair.first QByteArray may be a shallow copy pointing into the `bytes` QByteArray
-    std::vector<std::pair<QByteArray, Container>> entries; // only for Obj
+    using ValueVec = std::vector<Container, ArenaAllocator<Container>>;
+    using Entry = std::pair<QByteArray, Container>;
+    using EntryVec = std::vector<Entry, ArenaAllocator<Entry>>;
+    ValueVec values; // only for Arr
+    // Note that the below Entry.first QByteArray may be a shallow copy pointing into the `bytes` QByteArray
+    EntryVec entries; // only for Obj
+
+    explicit Container(Arena *a) noexcept
+        : values(ArenaAllocator<Container>{a}), entries(ArenaAllocator<Entry>{a}) {}
+    Container(Typ t, Arena *a) noexcept
+        : typ(t), values(ArenaAllocator<Container>{a}), entries(ArenaAllocator<Entry>{a}) {}
+    Container(Typ t, QByteArray &&d, Arena *a) noexcept
+        : typ(t), data(std::move(d)), values(ArenaAllocator<Container>{a}), entries(ArenaAllocator<Entry>{a}) {}
+    Container(Container &&) noexcept = default;
+    Container &operator=(Container &&) = default;
+
     void clear() { data.clear(); values.clear(); entries.clear(); typ = Null; }
     void setArr() { clear(); typ = Arr; }
     void setObj() { clear(); typ = Obj; }
     void setBool(bool b) { clear(); typ = b ? BoolTrue: BoolFalse; }
 
-    /// Recursively scours this container and its sub-containers and builds the proper QVariant / nesting.
-    /// Unlike this intermediate object, the resultant QVariant's string data (if any) will always be deep
-    /// copies of the original string data that came in.
-    QVariant toVariant() const;
+    /// Consumes this container and its sub-containers, building the proper QVariant / nesting.
+    /// Destructive by design: string/number payloads are released and child vectors cleared as each
+    /// node is converted, so the intermediate tree and the output QVariants never fully coexist --
+    /// roughly halving peak memory on large documents. (Every caller discards the tree right after
+    /// conversion anyway.) The resultant QVariant's string data (if any) will always be deep copies
+    /// of the original string data that came in.
+    QVariant takeVariant(Json::ObjectMode objMode = Json::ObjectMode::MapObjects);
+    /// As above, but reusing a caller-supplied key intern table (see Json::ParseContext).
+    QVariant takeVariant(struct KeyInterner &, Json::ObjectMode);
+
+    /// Iteratively drains this container's descendants so that its destructor runs without deep
+    /// recursion. Needed on error/reset paths: an abandoned partially-built tree is otherwise torn
+    /// down by ~Container -> ~vector recursion, one pair of frames per nesting level, which could
+    /// overflow the C++ stack for callers that raise maxDepth substantially and then hit a parse
+    /// error. (On success takeVariant() already leaves the tree drained, making this a no-op.)
+    void dismantle();
+private:
+    QVariant scalarToVariant() const;
+};
+
+/// Per-parse cache that deduplicates repeated object keys. Real-world corpora are often arrays of
+/// millions of objects sharing the same handful of keys ("txid", "fee", ...); without this, each
+/// occurrence got its own freshly-allocated QString. Interned QStrings share one allocation via
+/// Qt's implicit sharing. Keyed on the raw utf8 key bytes; lookups probe with a shallow view and
+/// only deep-copy the bytes when actually inserting a new key.
+struct KeyInterner {
+    QHash<QByteArray, QString> table;
+
+    QString intern(const QByteArray &key) {
+        const QByteArray view = QByteArray::fromRawData(key.constData(), key.size());
+        if (const auto it = table.constFind(view); it != table.constEnd())
+            return it.value();
+        // We use this C string syntax because it's faster & more accurate. (QString quirks)
+        QString s = QString::fromUtf8(key.constData(), key.size());
+        table.insert(QByteArray{key.constData(), key.size()} /* deep copy for storage */, s);
+        return s;
+    }
+};
+
+/// Powers of ten that are exactly representable as IEEE doubles (5^22 < 2^53).
+constexpr double PowersOfTen[23] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
 };
 
-/// recursively scours this container and its sub-containers and builds the proper QVariant / nesting
-QVariant Container::toVariant() const {
+/// Locale-independent fast-path conversion of a numeric token, operating directly on the token
+/// slice (no stack copy, no NUL termination needed). Handles the overwhelmingly common forms:
+/// 64-bit integers via plain digit accumulation with overflow checks, and doubles whose mantissa
+/// fits in 53 bits with a decimal exponent in [-22, 22] -- for those, a single IEEE multiply or
+/// divide by an exactly-representable power of ten yields the correctly-rounded result (the
+/// classic Clinger fast path, which is also the fast branch of Eisel-Lemire). Returns false for
+/// exotic forms (>19 significant digits, big exponents, out-of-range ints), which must take the
+/// strtod/strtoll fallback in Container::scalarToVariant() below.
+bool parseNumberFast(const char * const begin, const char * const end, QVariant &out)
+{
+    const char *p = begin;
+    bool neg = false;
+    if (p < end && *p == '-') { neg = true; ++p; }
+    uint64_t mant = 0;
+    int nDigits = 0;
+    const char * const intStart = p;
+    while (p < end) {
+        const unsigned d = unsigned(uint8_t(*p)) - unsigned('0');
+        if (d > 9) break;
+        mant = mant * 10u + d;
+        ++p;
+        if (UNLIKELY(++nDigits > 19)) return false; // may not fit in 64 bits -- take the slow path
+    }
+    if (UNLIKELY(p == intStart)) return false; // malformed (no digits) -- let the fallback produce the error
+    if (p == end) {
+        // pure integer token (note: <= 19 digits cannot overflow uint64, so `mant` is exact here)
+        if (neg) {
+            if (UNLIKELY(mant > uint64_t(1) << 63)) return false; // out of qlonglong range -- fallback throws
+            out = qlonglong(0u - mant); // two's complement negation; also correct for INT64_MIN
+        } else {
+            out = qulonglong(mant);
+        }
+        return true;
+    }
+    // double forms below
+    int exp10 = 0;
+    if (*p == '.') {
+        ++p;
+        const char * const fracStart = p;
+        while (p < end) {
+            const unsigned d = unsigned(uint8_t(*p)) - unsigned('0');
+            if (d > 9) break;
+            mant = mant * 10u + d;
+            ++p; --exp10;
+            if (UNLIKELY(++nDigits > 19)) return false;
+        }
+        if (UNLIKELY(p == fracStart)) return false; // malformed ("1.") -- let the fallback decide
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool eneg = false;
+        if (p < end && (*p == '+' || *p == '-')) { eneg = *p == '-'; ++p; }
+        const char * const expStart = p;
+        int e = 0;
+        while (p < end) {
+            const unsigned d = unsigned(uint8_t(*p)) - unsigned('0');
+            if (d > 9) break;
+            if (LIKELY(e < 10000)) e = e * 10 + int(d);
+            ++p;
+        }
+        if (UNLIKELY(p == expStart)) return false; // malformed ("1e") -- let the fallback decide
+        exp10 += eneg ? -e : e;
+    }
+    if (UNLIKELY(p != end)) return false;           // trailing junk -- let the fallback decide
+    if (mant >> 53) return false;                   // mantissa not exactly representable as a double
+    if (exp10 < -22 || exp10 > 22) return false;    // power of ten not exactly representable
+    double d = double(mant);
+    d = exp10 < 0 ? d / PowersOfTen[-exp10] : d * PowersOfTen[exp10];
+    out = neg ? -d : d;
+    return true;
+}
+
+QVariant Container::takeVariant(const Json::ObjectMode objMode) {
+    KeyInterner interner;
+    return takeVariant(interner, objMode);
+}
+
+/// converts a leaf (non-container) node to its QVariant; containers are handled iteratively in
+/// takeVariant() below
+QVariant Container::scalarToVariant() const {
+    JSON_STAT_ADD(valuesCreated, 1);
     QVariant ret;
     switch(typ) {
     case Null:
@@ -560,6 +881,13 @@ QVariant Container::toVariant() const {
             // this should never happen
             throw Json::ParseError("Data is empty for a nested item of type Num");
         }
+        // Common case: the locale-independent fast kernel handles the token in-place.
+        if (LIKELY(parseNumberFast(data.constData(), data.constData() + data.size(), ret)))
+            break;
+        // Slow path fallback for exotic forms (>19 significant digits, |exp10| > 22, etc).
+        // strtod honors LC_NUMERIC, so this rare path is the one place parsing still needs the
+        // locale check (the fast kernel above is locale-independent by construction).
+        Json::detail::ensureLocaleChecked();
         // NOTE .toDouble() is unsafe on raw shallow QByteArray - see QT-BUG 85580 and 86681.
         // Also note that .toLongLong() and .toULongLong() make an implicit deep copy of the data.
         // Since we want to avoid excess mallocs, we take a copy ourselves on the stack of the C-string
@@ -620,27 +948,395 @@ QVariant Container::toVariant() const {
         //              versus:  https://github.com/qt/qtbase/blob/ba3b53cb501a77144aa6259e48a8e0edc3d1481d/src/corelib/text/qstring.h#L709
         ret = QString::fromUtf8(data.constData(), data.size());
         break;
-    case Arr: {
-        QVariantList vl;
-        vl.reserve(values.size());
-        for (const auto & cont : values) {
-            vl.push_back(cont.toVariant());
+    case Arr:
+    case Obj:
+        assert(!"scalarToVariant() called on a container node");
+        break;
+    }
+    return ret;
+}
+
+/// scours this container and its sub-containers and builds the proper QVariant / nesting. Iterative
+/// with an explicit stack rather than recursive: deep machine-generated documents would otherwise
+/// consume one C++ stack frame per nesting level (limiting how far the runtime maxDepth can safely
+/// be raised), and wide trees convert faster without the per-element call overhead. Consuming: each
+/// node's heap payload (deep-copied string/key QByteArrays) is released the moment it has been
+/// converted, rather than lingering until the whole tree is torn down at the end.
+QVariant Container::takeVariant(KeyInterner &interner, const Json::ObjectMode objMode) {
+    if (typ != Arr && typ != Obj) {
+        QVariant ret = scalarToVariant(); // common leaf / bare-value case
+        data.clear();
+        return ret;
+    }
+
+    struct Frame {
+        Container *cont;
+        size_t idx = 0;       ///< next child of `cont` to convert
+        QVariantList list;    ///< accumulates children for Arr nodes
+        QVariantMap map;      ///< accumulates children for Obj nodes (MapObjects)
+        QVariantHash hash;    ///< accumulates children for Obj nodes (HashObjects)
+        explicit Frame(Container *c) : cont(c) {}
+    };
+    const bool useHash = objMode == Json::ObjectMode::HashObjects;
+
+    auto openFrame = [useHash](std::vector<Frame> &stack, Container *c) {
+        JSON_STAT_ADD(valuesCreated, 1);
+        auto &f = stack.emplace_back(c);
+        if (c->typ == Arr)
+            f.list.reserve(c->values.size());
+        else if (useHash)
+            f.hash.reserve(int(c->entries.size())); // known entry count -- avoids rehashes
+    };
+    auto appendTo = [&interner, useHash](Frame &f, QVariant &&v) {
+        // NB: f.idx has already been advanced past the child being appended here
+        if (f.cont->typ == Arr)
+            f.list.push_back(std::move(v));
+        else {
+            // NB: key (pair.first in entries) may be a deep or shallow copy of the data in `bytes`;
+            // interning deduplicates the QString allocation for keys repeated across objects
+            const QByteArray &key = f.cont->entries[f.idx - 1].first;
+            if (useHash)
+                f.hash.insert(interner.intern(key), std::move(v));
+            else
+                f.map.insert(interner.intern(key), std::move(v));
+        }
+    };
+
+    std::vector<Frame> stack;
+    stack.reserve(16);
+    openFrame(stack, this);
+    for (;;) {
+        Frame &f = stack.back();
+        Container &c = *f.cont;
+        const size_t nChildren = c.typ == Arr ? c.values.size() : c.entries.size();
+        if (f.idx < nChildren) {
+            Container &child = c.typ == Arr ? c.values[f.idx] : c.entries[f.idx].second;
+            ++f.idx;
+            if (child.typ == Arr || child.typ == Obj)
+                openFrame(stack, &child); // note: invalidates `f`
+            else {
+                appendTo(f, child.scalarToVariant());
+                child.data.clear(); // release a deep-copied Str payload now rather than at tree teardown
+            }
+            continue;
+        }
+        // frame complete -- package it up, dismantle the consumed node, and hand the result to the
+        // parent frame (or return it). Clearing the child vectors here destroys the converted
+        // children's remaining QByteArrays (keys, any payloads); the vectors' own storage is
+        // arena-backed and reclaimed wholesale later as always.
+        QVariant built;
+        if (c.typ == Arr)
+            built = f.list;
+        else if (useHash)
+            built = f.hash;
+        else
+            built = f.map;
+        c.values.clear();
+        c.entries.clear();
+        stack.pop_back();
+        if (stack.empty())
+            return built;
+        appendTo(stack.back(), std::move(built));
+    }
+}
+
+void Container::dismantle()
+{
+    if (values.empty() && entries.empty())
+        return; // scalar, or already drained by takeVariant()
+    // Classic iterative tree deletion: move each node that still has grandchildren onto an explicit
+    // worklist, clear its parent's child vector (now one level deep, so no recursion), and let the
+    // moved-out node destruct at the bottom of the loop once its own children have been drained.
+    std::vector<Container> pending;
+    const auto drain = [&pending](Container &c) {
+        for (auto & child : c.values)
+            if (!child.values.empty() || !child.entries.empty())
+                pending.push_back(std::move(child));
+        c.values.clear();
+        for (auto & entry : c.entries)
+            if (!entry.second.values.empty() || !entry.second.entries.empty())
+                pending.push_back(std::move(entry.second));
+        c.entries.clear();
+    };
+    drain(*this);
+    while (!pending.empty()) {
+        Container c{std::move(pending.back())};
+        pending.pop_back();
+        drain(c); // `c` destructs childless at end of this iteration
+    }
+}
+
+/// Push-parser state machine for the Default backend. One token is processed per processToken() call.
+/// Both Json::detail::parse() (one-shot) and Json::StreamParser (incremental) drive this same machinery;
+/// the latter keeps an instance alive across feed() calls.
+struct ParserState {
+    enum ExpectBits : uint32_t {
+        EXP_OBJ_NAME = 1U << 0,
+        EXP_COLON = 1U << 1,
+        EXP_ARR_VALUE = 1U << 2,
+        EXP_VALUE = 1U << 3,
+        EXP_NOT_VALUE = 1U << 4,
+    };
+    uint32_t expectMask = 0;
+
+    size_t maxDepth = MAX_JSON_DEPTH; ///< nesting depth beyond which processToken() rejects the input
+
+    Arena arena; ///< slab storage for the Container tree rooted at `root`; freed/rewound wholesale
+    Container root{&arena};
+    std::vector<Container *> stack;
+    jtokentype last_tok = JTOK_NONE;
+    bool started = false; ///< latched true once the first token has been processed
+
+    ~ParserState() { root.dismantle(); } // keep teardown of an abandoned deep tree iterative
+
+    void reset() {
+        expectMask = 0;
+        stack.clear();
+        root.dismantle(); // in case the last parse errored out partway, drain without recursing
+        root = Container{&arena}; // destroy the old tree *before* rewinding its backing slabs
+        arena.reset();
+        last_tok = JTOK_NONE;
+        started = false;
+    }
+
+    /// true once a complete top-level value has been parsed
+    bool atEnd() const noexcept { return started && stack.empty(); }
+
+    /// Process a single token (must not be JTOK_NONE or JTOK_ERR). `tokenVal` is consumed (moved-from)
+    /// for JTOK_NUMBER and JTOK_STRING tokens. Returns false on structurally invalid input.
+    bool processToken(jtokentype tok, QByteArray &tokenVal);
+};
+
+bool ParserState::processToken(const jtokentype tok, QByteArray &tokenVal)
+{
+#   define expect(bit) (expectMask & ExpectBits::EXP_##bit)
+#   define setExpect(bit) (expectMask |= ExpectBits::EXP_##bit)
+#   define clearExpect(bit) (expectMask &= ~ExpectBits::EXP_##bit)
+
+    using VType = Container::Typ;
+
+    started = true;
+
+    const bool isValueOpen = jsonTokenIsValue(tok) || tok == JTOK_OBJ_OPEN || tok == JTOK_ARR_OPEN;
+
+    if (expect(VALUE)) {
+        if (!isValueOpen)
+            return false;
+        clearExpect(VALUE);
+
+    } else if (expect(ARR_VALUE)) {
+        bool isArrValue = isValueOpen || tok == JTOK_ARR_CLOSE;
+        if (!isArrValue)
+            return false;
+
+        clearExpect(ARR_VALUE);
+
+    } else if (expect(OBJ_NAME)) {
+        bool isObjName = tok == JTOK_OBJ_CLOSE || tok == JTOK_STRING;
+        if (!isObjName)
+            return false;
+
+    } else if (expect(COLON)) {
+        if (tok != JTOK_COLON)
+            return false;
+        clearExpect(COLON);
+
+    } else if (!expect(COLON) && tok == JTOK_COLON) {
+        return false;
+    }
+
+    if (expect(NOT_VALUE)) {
+        if (isValueOpen)
+            return false;
+        clearExpect(NOT_VALUE);
+    }
+
+    switch (tok) {
+
+    case JTOK_OBJ_OPEN:
+    case JTOK_ARR_OPEN: {
+        VType utyp = (tok == JTOK_OBJ_OPEN ? VType::Obj : VType::Arr);
+        if (stack.empty()) {
+            if (utyp == VType::Obj)
+                root.setObj();
+            else
+                root.setArr();
+            stack.push_back(&root);
+        } else {
+            Container *top = stack.back();
+            if (top->typ == VType::Obj) {
+                // paranoia
+                if (UNLIKELY(top->entries.empty())) {
+                    qCritical() << "Json Parser ERROR: Obj 'entries' is empty; FIXME!";
+                    return false;
+                }
+                // /paranoia
+                auto& entry = top->entries.back();
+                if (utyp == VType::Obj)
+                    entry.second.setObj();
+                else
+                    entry.second.setArr();
+                stack.push_back(&entry.second);
+            } else {
+                top->values.emplace_back(utyp, &arena);
+                stack.push_back(&top->values.back());
+            }
+        }
+
+        if (UNLIKELY(stack.size() > maxDepth))
+            return false;
+
+        if (utyp == VType::Obj)
+            setExpect(OBJ_NAME);
+        else
+            setExpect(ARR_VALUE);
+        break;
+    }
+
+    case JTOK_OBJ_CLOSE:
+    case JTOK_ARR_CLOSE: {
+        if (UNLIKELY(stack.empty() || last_tok == JTOK_COMMA))
+            return false;
+
+        VType utyp = (tok == JTOK_OBJ_CLOSE ? VType::Obj : VType::Arr);
+        Container *top = stack.back();
+        if (UNLIKELY(utyp != top->typ))
+            return false;
+
+        stack.pop_back();
+        clearExpect(OBJ_NAME);
+        setExpect(NOT_VALUE);
+        break;
+    }
+
+    case JTOK_COLON: {
+        if (UNLIKELY(stack.empty()))
+            return false;
+
+        Container *top = stack.back();
+        if (UNLIKELY(top->typ != VType::Obj))
+            return false;
+
+        setExpect(VALUE);
+        break;
+    }
+
+    case JTOK_COMMA: {
+        if (UNLIKELY(stack.empty() || last_tok == JTOK_COMMA || last_tok == JTOK_ARR_OPEN))
+            return false;
+
+        Container *top = stack.back();
+        if (top->typ == VType::Obj)
+            setExpect(OBJ_NAME);
+        else
+            setExpect(ARR_VALUE);
+        break;
+    }
+
+    case JTOK_KW_NULL:
+    case JTOK_KW_TRUE:
+    case JTOK_KW_FALSE: {
+        Container tmpVal{&arena};
+        switch (tok) {
+        case JTOK_KW_NULL:
+            // do nothing more
+            break;
+        case JTOK_KW_TRUE:
+            tmpVal.setBool(true);
+            break;
+        case JTOK_KW_FALSE:
+            tmpVal.setBool(false);
+            break;
+        default: /* impossible */ break;
+        }
+
+        if (stack.empty()) {
+            root = std::move(tmpVal);
+            break;
+        }
+
+        Container *top = stack.back();
+        if (top->typ == VType::Obj) {
+            // paranoia
+            if (UNLIKELY(top->entries.empty())) {
+                qCritical() << "Json Parser ERROR: Obj 'entries' is empty when parsing a keyword; FIXME!";
+                return false;
+            }
+            // /paranoia
+            top->entries.back().second = std::move(tmpVal);
+        } else {
+            top->values.emplace_back(std::move(tmpVal));
+        }
+
+        setExpect(NOT_VALUE);
+        break;
+    }
+
+    case JTOK_NUMBER: {
+        Container tmpVal{VType::Num, std::move(tokenVal), &arena};
+        if (stack.empty()) {
+            root = std::move(tmpVal);
+            break;
+        }
+
+        Container *top = stack.back();
+        if (top->typ == VType::Obj) {
+            // paranoia
+            if (UNLIKELY(top->entries.empty())) {
+                qCritical() << "Json Parser ERROR: Obj 'entries' is empty when parsing a number; FIXME!";
+                return false;
+            }
+            // /paranoia
+            top->entries.back().second = std::move(tmpVal);
+        } else {
+            top->values.emplace_back(std::move(tmpVal));
         }
-        ret = vl;
+
+        setExpect(NOT_VALUE);
         break;
     }
-    case Obj: {
-        // NB: pair.first in entries may be a deep or shallow copy of the data in `bytes`
-        QVariantMap vm;
-        for (const auto & [key, cont] : entries) {
-            // We use this C string syntax because it's faster & more accurate. (QString quirks)
-            vm[QString::fromUtf8(key.constData(), key.size())] = cont.toVariant();
+
+    case JTOK_STRING: {
+        if (expect(OBJ_NAME)) {
+            Container *top = stack.back();
+            top->entries.emplace_back(std::piecewise_construct,
+                                      std::forward_as_tuple(std::move(tokenVal)),
+                                      std::forward_as_tuple(&arena));
+            clearExpect(OBJ_NAME);
+            setExpect(COLON);
+        } else {
+            Container tmpVal{VType::Str, std::move(tokenVal), &arena};
+            if (stack.empty()) {
+                root = std::move(tmpVal);
+                break;
+            }
+            Container *top = stack.back();
+            if (top->typ == VType::Obj) {
+                // paranoia
+                if (UNLIKELY(top->entries.empty())) {
+                    qCritical() << "Json Parser ERROR: Obj 'entries' is empty when parsing a string; FIXME!";
+                    return false;
+                }
+                // /paranoia
+                top->entries.back().second = std::move(tmpVal);
+            } else {
+                top->values.emplace_back(std::move(tmpVal));
+            }
         }
-        ret = vm;
+
+        setExpect(NOT_VALUE);
         break;
     }
+
+    default:
+        return false;
     }
-    return ret;
+
+    last_tok = tok;
+    return true;
+#   undef expect
+#   undef setExpect
+#   undef clearExpect
 }
 } // end anonymous namespace
 
@@ -655,21 +1351,10 @@ bool isParserAvailable(ParserBackend backend) {
     return false; // not reached
 }
 
-namespace detail {
-
-namespace {
-/// May throw ParserUnavailable if the simdjson parser is not compiled-in
-bool sjParse(QVariant &out, const QByteArray &bytes);
-}
+EventHandler::~EventHandler() {} // for vtable
 
-bool parse(QVariant &out, const QByteArray &bytes, ParserBackend backend)
+bool parseEvents(const QByteArray &bytes, EventHandler &handler)
 {
-    if (backend == ParserBackend::SimdJson
-            || (backend == ParserBackend::FastestAvailable && isParserAvailable(ParserBackend::SimdJson)))
-        return sjParse(out, bytes);
-
-    // "Default" (internal) parser implementation below
-
     enum ExpectBits : uint32_t {
         EXP_OBJ_NAME = 1U << 0,
         EXP_COLON = 1U << 1,
@@ -682,10 +1367,18 @@ bool parse(QVariant &out, const QByteArray &bytes, ParserBackend backend)
 #   define setExpect(bit) (expectMask |= ExpectBits::EXP_##bit)
 #   define clearExpect(bit) (expectMask &= ~ExpectBits::EXP_##bit)
 
-    out = QVariant{}; // ensure cleared
-
-    Container root;
-    std::vector<Container *> stack;
+    // Unlike detail::parse() we don't build any Container tree here -- all we need to remember per
+    // nesting level is whether we are inside an object or an array.
+    enum : uint8_t { StObj, StArr };
+    std::vector<uint8_t> stack;
+    stack.reserve(64);
+
+    // note: unlike detail::parse(), malformed JSON here throws rather than returning false; the
+    // return value of this function is reserved for handler-initiated aborts.
+    const auto Fail = [&bytes]() -> ParseError {
+        return ParseError(QString("Failed to parse Json from string: %1%2").arg(QString(bytes.left(80)))
+                          .arg(bytes.size() > 80 ? "..." : ""));
+    };
 
     QByteArray tokenVal;
     unsigned consumed;
@@ -694,49 +1387,44 @@ bool parse(QVariant &out, const QByteArray &bytes, ParserBackend backend)
     const char *raw = bytes.constData();
     const char * const end = raw + bytes.size();
     do {
-        using VType = Container::Typ;
-
         last_tok = tok;
 
-        /* Note: getJsonToken modifies `tokenVal` *only if* return val was
-         * JTOK_NUMBER or JTOK_STRING, but it may also modify it on JTOK_ERR,
-         * leaving `tokenVal` in an unspecified state. */
         tok = getJsonToken(tokenVal, consumed, raw, end);
         if (tok == JTOK_NONE || tok == JTOK_ERR)
-            return false;
+            throw Fail();
         raw += consumed;
 
         const bool isValueOpen = jsonTokenIsValue(tok) || tok == JTOK_OBJ_OPEN || tok == JTOK_ARR_OPEN;
 
         if (expect(VALUE)) {
             if (!isValueOpen)
-                return false;
+                throw Fail();
             clearExpect(VALUE);
 
         } else if (expect(ARR_VALUE)) {
-            bool isArrValue = isValueOpen || tok == JTOK_ARR_CLOSE;
+            const bool isArrValue = isValueOpen || tok == JTOK_ARR_CLOSE;
             if (!isArrValue)
-                return false;
+                throw Fail();
 
             clearExpect(ARR_VALUE);
 
         } else if (expect(OBJ_NAME)) {
-            bool isObjName = tok == JTOK_OBJ_CLOSE || tok == JTOK_STRING;
+            const bool isObjName = tok == JTOK_OBJ_CLOSE || tok == JTOK_STRING;
             if (!isObjName)
-                return false;
+                throw Fail();
 
         } else if (expect(COLON)) {
             if (tok != JTOK_COLON)
-                return false;
+                throw Fail();
             clearExpect(COLON);
 
         } else if (!expect(COLON) && tok == JTOK_COLON) {
-            return false;
+            throw Fail();
         }
 
         if (expect(NOT_VALUE)) {
             if (isValueOpen)
-                return false;
+                throw Fail();
             clearExpect(NOT_VALUE);
         }
 
@@ -744,67 +1432,44 @@ bool parse(QVariant &out, const QByteArray &bytes, ParserBackend backend)
 
         case JTOK_OBJ_OPEN:
         case JTOK_ARR_OPEN: {
-            VType utyp = (tok == JTOK_OBJ_OPEN ? VType::Obj : VType::Arr);
-            if (stack.empty()) {
-                if (utyp == VType::Obj)
-                    root.setObj();
-                else
-                    root.setArr();
-                stack.push_back(&root);
-            } else {
-                Container *top = stack.back();
-                if (top->typ == VType::Obj) {
-                    // paranoia
-                    if (UNLIKELY(top->entries.empty())) {
-                        qCritical() << "Json Parser ERROR: Obj 'entries' is empty; FIXME!";
-                        return false;
-                    }
-                    // /paranoia
-                    auto& entry = top->entries.back();
-                    if (utyp == VType::Obj)
-                        entry.second.setObj();
-                    else
-                        entry.second.setArr();
-                    stack.push_back(&entry.second);
-                } else {
-                    top->values.emplace_back(Container{utyp, {}, {}, {}});
-                    stack.push_back(&top->values.back());
-                }
-            }
+            const bool isObj = tok == JTOK_OBJ_OPEN;
+            stack.push_back(isObj ? StObj : StArr);
 
             if (UNLIKELY(stack.size() > MAX_JSON_DEPTH))
-                return false;
+                throw Fail();
 
-            if (utyp == VType::Obj)
+            if (isObj) {
+                if (!handler.onObjectStart())
+                    return false;
                 setExpect(OBJ_NAME);
-            else
+            } else {
+                if (!handler.onArrayStart())
+                    return false;
                 setExpect(ARR_VALUE);
+            }
             break;
         }
 
         case JTOK_OBJ_CLOSE:
         case JTOK_ARR_CLOSE: {
             if (UNLIKELY(stack.empty() || last_tok == JTOK_COMMA))
-                return false;
+                throw Fail();
 
-            VType utyp = (tok == JTOK_OBJ_CLOSE ? VType::Obj : VType::Arr);
-            Container *top = stack.back();
-            if (UNLIKELY(utyp != top->typ))
-                return false;
+            const bool isObj = tok == JTOK_OBJ_CLOSE;
+            if (UNLIKELY((isObj ? StObj : StArr) != stack.back()))
+                throw Fail();
 
             stack.pop_back();
             clearExpect(OBJ_NAME);
             setExpect(NOT_VALUE);
+            if (!(isObj ? handler.onObjectEnd() : handler.onArrayEnd()))
+                return false;
             break;
         }
 
         case JTOK_COLON: {
-            if (UNLIKELY(stack.empty()))
-                return false;
-
-            Container *top = stack.back();
-            if (UNLIKELY(top->typ != VType::Obj))
-                return false;
+            if (UNLIKELY(stack.empty() || stack.back() != StObj))
+                throw Fail();
 
             setExpect(VALUE);
             break;
@@ -812,10 +1477,9 @@ bool parse(QVariant &out, const QByteArray &bytes, ParserBackend backend)
 
         case JTOK_COMMA: {
             if (UNLIKELY(stack.empty() || last_tok == JTOK_COMMA || last_tok == JTOK_ARR_OPEN))
-                return false;
+                throw Fail();
 
-            Container *top = stack.back();
-            if (top->typ == VType::Obj)
+            if (stack.back() == StObj)
                 setExpect(OBJ_NAME);
             else
                 setExpect(ARR_VALUE);
@@ -823,112 +1487,502 @@ bool parse(QVariant &out, const QByteArray &bytes, ParserBackend backend)
         }
 
         case JTOK_KW_NULL:
-        case JTOK_KW_TRUE:
-        case JTOK_KW_FALSE: {
-            Container tmpVal;
-            switch (tok) {
-            case JTOK_KW_NULL:
-                // do nothing more
-                break;
-            case JTOK_KW_TRUE:
-                tmpVal.setBool(true);
-                break;
-            case JTOK_KW_FALSE:
-                tmpVal.setBool(false);
-                break;
-            default: /* impossible */ break;
-            }
-
-            if (stack.empty()) {
-                root = std::move(tmpVal);
-                break;
-            }
-
-            Container *top = stack.back();
-            if (top->typ == VType::Obj) {
-                // paranoia
-                if (UNLIKELY(top->entries.empty())) {
-                    qCritical() << "Json Parser ERROR: Obj 'entries' is empty when parsing a keyword; FIXME!";
-                    return false;
-                }
-                // /paranoia
-                top->entries.back().second = std::move(tmpVal);
-            } else {
-                top->values.emplace_back(std::move(tmpVal));
-            }
-
+            if (!handler.onNull())
+                return false;
             setExpect(NOT_VALUE);
             break;
-        }
 
-        case JTOK_NUMBER: {
-            Container tmpVal{VType::Num, std::move(tokenVal), {}, {}};
-            if (stack.empty()) {
-                root = std::move(tmpVal);
-                break;
-            }
-
-            Container *top = stack.back();
-            if (top->typ == VType::Obj) {
-                // paranoia
-                if (UNLIKELY(top->entries.empty())) {
-                    qCritical() << "Json Parser ERROR: Obj 'entries' is empty when parsing a number; FIXME!";
-                    return false;
-                }
-                // /paranoia
-                top->entries.back().second = std::move(tmpVal);
-            } else {
-                top->values.emplace_back(std::move(tmpVal));
-            }
+        case JTOK_KW_TRUE:
+        case JTOK_KW_FALSE:
+            if (!handler.onBool(tok == JTOK_KW_TRUE))
+                return false;
+            setExpect(NOT_VALUE);
+            break;
 
+        case JTOK_NUMBER:
+            if (!handler.onNumber(tokenVal))
+                return false;
             setExpect(NOT_VALUE);
             break;
-        }
 
         case JTOK_STRING: {
             if (expect(OBJ_NAME)) {
-                Container *top = stack.back();
-                top->entries.emplace_back(std::piecewise_construct,
-                                          std::forward_as_tuple(std::move(tokenVal)),
-                                          std::forward_as_tuple());
+                if (!handler.onKey(tokenVal))
+                    return false;
                 clearExpect(OBJ_NAME);
                 setExpect(COLON);
             } else {
-                Container tmpVal{VType::Str, std::move(tokenVal), {}, {}};
-                if (stack.empty()) {
-                    root = std::move(tmpVal);
-                    break;
-                }
-                Container *top = stack.back();
-                if (top->typ == VType::Obj) {
-                    // paranoia
-                    if (UNLIKELY(top->entries.empty())) {
-                        qCritical() << "Json Parser ERROR: Obj 'entries' is empty when parsing a string; FIXME!";
-                        return false;
-                    }
-                    // /paranoia
-                    top->entries.back().second = std::move(tmpVal);
-                } else {
-                    top->values.emplace_back(std::move(tmpVal));
-                }
+                if (!handler.onString(tokenVal))
+                    return false;
+                setExpect(NOT_VALUE);
             }
-
-            setExpect(NOT_VALUE);
             break;
         }
 
         default:
-            return false;
+            throw Fail();
         }
     } while (!stack.empty());
 
     /* Check that nothing follows the initial construct (parsed above).  */
     tok = getJsonToken(tokenVal, consumed, raw, end);
     if (tok != JTOK_NONE)
+        throw Fail();
+
+    return true;
+#   undef expect
+#   undef setExpect
+#   undef clearExpect
+}
+
+struct StreamParser::Impl {
+    ParserState ps;
+    QByteArray carry;      ///< unconsumed tail bytes carried over between feed() calls
+    bool finished = false; ///< set by result() once the final tokens have been flushed
+    QVariant res;          ///< cached result (only valid once `finished`)
+
+    /// Tokenize & commit as much of [raw, end) as possible into `ps`. Returns the number of bytes
+    /// committed (always <= end-raw; the remainder must be re-presented with the next chunk). If
+    /// `eof` is true, the buffer is the very end of the input and every token in it must be complete.
+    /// Throws ParseError on malformed input.
+    size_t pump(const char *raw, const char * const end, bool eof);
+};
+
+size_t StreamParser::Impl::pump(const char *raw, const char * const end, const bool eof)
+{
+    const char * const start = raw;
+    QByteArray tokenVal;
+    unsigned consumed;
+    for (;;) {
+        const jtokentype tok = getJsonToken(tokenVal, consumed, raw, end);
+        if (tok == JTOK_NONE)
+            break; // nothing but whitespace (if anything) left
+        if (tok == JTOK_ERR) {
+            // At a chunk boundary this may simply be a token that was cut mid-way (e.g. a string
+            // missing its closing quote so far) -- stall and wait for more data, unless this really
+            // is the end of the input, in which case the document is definitely malformed.
+            if (eof)
+                throw ParseError("StreamParser: malformed JSON");
+            break;
+        }
+        // A number or keyword that runs flush up against the end of the available data may be
+        // continued by the next chunk (e.g. "12" + "3"), so it can only be committed once more
+        // data (or end-of-input) arrives.
+        if (!eof && raw + consumed == end
+                && (tok == JTOK_NUMBER || tok == JTOK_KW_NULL || tok == JTOK_KW_TRUE || tok == JTOK_KW_FALSE))
+            break;
+        if (UNLIKELY(ps.atEnd()))
+            throw ParseError("StreamParser: unexpected data after the top-level JSON value");
+        if (tok == JTOK_NUMBER || tok == JTOK_STRING) {
+            // `tokenVal` may be a shallow view into the current chunk or the carry buffer, neither
+            // of which outlives this call -- force a deep copy before it enters the Container tree.
+            tokenVal = QByteArray{tokenVal.constData(), int(tokenVal.size())};
+        }
+        if (UNLIKELY(!ps.processToken(tok, tokenVal)))
+            throw ParseError("StreamParser: malformed JSON");
+        raw += consumed;
+    }
+    return size_t(raw - start);
+}
+
+StreamParser::StreamParser() : p(new Impl) {}
+StreamParser::~StreamParser() {}
+StreamParser::StreamParser(StreamParser &&) noexcept = default;
+StreamParser &StreamParser::operator=(StreamParser &&) noexcept = default;
+
+void StreamParser::feed(const char *data, std::size_t len)
+{
+    Impl &d = *p;
+    if (UNLIKELY(d.finished))
+        throw Error("StreamParser: feed() called after result() (call reset() first to reuse this object)");
+    if (!len)
+        return;
+    if (d.carry.isEmpty()) {
+        // common case: parse straight out of the caller's buffer, no copying of committed bytes
+        const size_t committed = d.pump(data, data + len, false);
+        if (committed < len)
+            d.carry.append(data + committed, int(len - committed));
+    } else {
+        d.carry.append(data, int(len));
+        const size_t committed = d.pump(d.carry.constData(), d.carry.constData() + d.carry.size(), false);
+        if (committed)
+            d.carry.remove(0, int(committed));
+    }
+}
+
+bool StreamParser::done() const noexcept { return p->finished || p->ps.atEnd(); }
+
+QVariant StreamParser::result(ParseOption opt)
+{
+    Impl &d = *p;
+    if (!d.finished) {
+        if (!d.carry.isEmpty()) {
+            const size_t committed = d.pump(d.carry.constData(), d.carry.constData() + d.carry.size(), true);
+            d.carry.remove(0, int(committed)); // anything left now is guaranteed to be whitespace
+        }
+        if (UNLIKELY(!d.ps.atEnd()))
+            throw ParseError("StreamParser: input ended in the middle of a JSON document");
+        try {
+            d.res = d.ps.root.takeVariant(); // convert to (possibly nested) QVariant containing QVariants
+        } catch (const Error &) {
+            throw;
+        } catch (const std::exception &e) {
+            // this is unlikely to happen, but may if std::bad_alloc (or if bugs in this code).
+            throw ParseError(QString("StreamParser: %1").arg(e.what()));
+        }
+        d.ps.reset(); // the Container tree is no longer needed; free it now
+        d.finished = true;
+    }
+    if (opt == ParseOption::RequireObject && QMetaType::Type(d.res.type()) != QMetaType::QVariantMap)
+        throw Error("Json Error: expected object");
+    if (opt == ParseOption::RequireArray && QMetaType::Type(d.res.type()) != QMetaType::QVariantList)
+        throw Error("Json Error: expected array");
+    return d.res;
+}
+
+void StreamParser::reset()
+{
+    Impl &d = *p;
+    d.ps.reset();
+    d.carry.clear();
+    d.finished = false;
+    d.res = QVariant{};
+}
+
+struct ParseContext::Impl {
+    ParserState ps;       ///< arena slabs and depth-stack capacity persist across parse() calls
+    QByteArray tokenVal;  ///< tokenizer scratch
+    KeyInterner interner; ///< object-key cache persists across parse() calls (RPC bodies repeat keys)
+
+    /// Bound the interner's growth; steady-state workloads see a few dozen distinct keys, but a
+    /// hostile/odd stream of ever-changing keys must not pin memory forever.
+    static constexpr int MaxInternedKeys = 4096;
+};
+
+ParseContext::ParseContext() : p(new Impl) {}
+ParseContext::~ParseContext() {}
+ParseContext::ParseContext(ParseContext &&) noexcept = default;
+ParseContext &ParseContext::operator=(ParseContext &&) noexcept = default;
+
+QVariant ParseContext::parse(const QByteArray &bytes, ParseOption opt, ObjectMode objMode, std::size_t maxDepth)
+{
+    Impl &d = *p;
+    JSON_STAT_ADD(parsesDefault, 1);
+    d.ps.reset(); // rewinds the arena and clears the stack; both keep their capacity
+    d.ps.maxDepth = maxDepth;
+    if (d.interner.table.size() > Impl::MaxInternedKeys)
+        d.interner.table.clear();
+
+    const auto Fail = [&bytes] {
+        return ParseError(QString("Failed to parse Json from string: %1%2").arg(QString(bytes.left(80)))
+                          .arg(bytes.size() > 80 ? "..." : ""));
+    };
+    unsigned consumed;
+    const char *raw = bytes.constData();
+    const char * const end = raw + bytes.size();
+    do {
+        const jtokentype tok = getJsonToken(d.tokenVal, consumed, raw, end);
+        if (tok == JTOK_NONE || tok == JTOK_ERR)
+            throw Fail();
+        raw += consumed;
+        if (!d.ps.processToken(tok, d.tokenVal))
+            throw Fail();
+    } while (!d.ps.stack.empty());
+
+    /* Check that nothing follows the initial construct (parsed above).  */
+    if (getJsonToken(d.tokenVal, consumed, raw, end) != JTOK_NONE)
+        throw Fail();
+
+    QVariant ret = d.ps.root.takeVariant(d.interner, objMode);
+    d.ps.reset(); // drop the Container tree now (it may hold deep copies of token data)
+
+    const auto objType = objMode == ObjectMode::HashObjects ? QMetaType::QVariantHash : QMetaType::QVariantMap;
+    if (opt == ParseOption::RequireObject && QMetaType::Type(ret.type()) != objType)
+        throw Error("Json Error: expected object");
+    if (opt == ParseOption::RequireArray && QMetaType::Type(ret.type()) != QMetaType::QVariantList)
+        throw Error("Json Error: expected array");
+    return ret;
+}
+
+QVariantList parseLines(const QByteArray &ndjson, ParserBackend backend, int maxThreads)
+{
+    if (UNLIKELY(!isParserAvailable(backend)))
+        throw ParserUnavailable("Json Error: The SimdJson parser is not available");
+
+    // split the buffer into records on '\n' boundaries (NDJSON guarantees no raw newlines inside a
+    // record since strings must escape them); blank lines are skipped
+    struct Record {
+        const char *begin;
+        int size, lineNum;
+    };
+    std::vector<Record> records;
+    {
+        const char *p = ndjson.constData();
+        const char * const end = p + ndjson.size();
+        int lineNum = 1;
+        while (p < end) {
+            const char *nl = static_cast<const char *>(std::memchr(p, '\n', size_t(end - p)));
+            const char * const recEnd = nl ? nl : end;
+            const char *q = p;
+            while (q < recEnd && json_isspace(uint8_t(*q))) // skip blank lines
+                ++q;
+            if (q < recEnd)
+                records.push_back(Record{p, int(recEnd - p), lineNum});
+            p = recEnd + 1;
+            ++lineNum;
+        }
+    }
+
+    QVariantList ret;
+    if (records.empty())
+        return ret;
+    ret.reserve(int(records.size()));
+
+    unsigned nThreads = maxThreads > 0 ? unsigned(maxThreads) : std::thread::hardware_concurrency();
+    nThreads = std::max(1U, std::min(nThreads, unsigned(records.size())));
+
+    const auto parseRecord = [backend](const Record &rec) -> QVariant {
+        QVariant var;
+        // shallow view -- detail::parse takes deep copies of everything it keeps
+        if (!detail::parse(var, QByteArray::fromRawData(rec.begin, rec.size), backend))
+            throw ParseError(QString("Failed to parse NDJSON record at line %1: %2%3")
+                             .arg(rec.lineNum).arg(QString::fromUtf8(rec.begin, std::min(rec.size, 80)))
+                             .arg(rec.size > 80 ? "..." : ""));
+        return var;
+    };
+
+    if (nThreads == 1) {
+        for (const auto &rec : records)
+            ret.push_back(parseRecord(rec));
+        return ret;
+    }
+
+    std::vector<QVariant> results(records.size());
+    std::atomic_size_t next{0};
+    std::atomic_bool failed{false};
+    std::exception_ptr firstError;
+    std::mutex errorMut;
+
+    const auto worker = [&] {
+        for (;;) {
+            const size_t i = next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= records.size() || failed.load(std::memory_order_relaxed))
+                return;
+            try {
+                results[i] = parseRecord(records[i]);
+            } catch (...) {
+                failed = true;
+                std::unique_lock g(errorMut);
+                if (!firstError)
+                    firstError = std::current_exception();
+                return;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(nThreads);
+    for (unsigned t = 0; t < nThreads; ++t)
+        threads.emplace_back(worker);
+    for (auto &thr : threads)
+        thr.join();
+
+    if (failed)
+        std::rethrow_exception(firstError);
+
+    for (auto &var : results)
+        ret.push_back(std::move(var));
+    return ret;
+}
+
+namespace {
+/// Structural pre-scan used by parseUtf8Parallel(): locates the [begin, end) byte ranges of the
+/// top-level elements of a root array without tokenizing anything -- it only tracks string/escape
+/// state and bracket depth. Returns false if the input does not look like a well-formed top-level
+/// array (the caller then falls back to the sequential parser, which produces the proper error).
+bool scanTopLevelArray(const QByteArray &ba, std::vector<std::pair<int, int>> &elems)
+{
+    const char * const base = ba.constData();
+    const char *p = base;
+    const char * const end = base + ba.size();
+    while (p < end && json_isspace(uint8_t(*p)))
+        ++p;
+    if (p >= end || *p != '[')
+        return false;
+    ++p;
+    const char *q = p;
+    while (q < end && json_isspace(uint8_t(*q)))
+        ++q;
+    if (q < end && *q == ']') {
+        p = q + 1; // empty array
+    } else {
+        for (;;) {
+            const char * const elemBegin = p;
+            const char *elemEnd = nullptr; // will point at the ',' or ']' terminating this element
+            int depth = 0;
+            bool inString = false;
+            for (; p < end && !elemEnd; ++p) {
+                const char c = *p;
+                if (inString) {
+                    if (c == '\\') {
+                        if (UNLIKELY(++p >= end)) // skip the escaped char (it may be '"' or '\\')
+                            return false;
+                    } else if (c == '"')
+                        inString = false;
+                } else switch (c) {
+                case '"': inString = true; break;
+                case '[': case '{': ++depth; break;
+                case ']': case '}':
+                    if (--depth < 0) {
+                        if (c != '}')
+                            elemEnd = p; // the root array's closing ']'
+                        else
+                            return false; // mismatched bracket
+                    }
+                    break;
+                case ',': if (depth == 0) elemEnd = p; break;
+                default: break;
+                }
+            }
+            if (!elemEnd)
+                return false; // ran off the end mid-element (unterminated string, array, etc)
+            // note: degenerate slices (e.g. the empty one in "[1,,2]") are recorded as-is; the
+            // worker's per-element parse rejects them with the usual ParseError
+            elems.emplace_back(int(elemBegin - base), int(elemEnd - base));
+            if (*elemEnd == ']')
+                break;
+        }
+    }
+    while (p < end && json_isspace(uint8_t(*p)))
+        ++p;
+    return p == end; // anything trailing the root array -> let the sequential parser report it
+}
+} // namespace
+
+QVariant parseUtf8Parallel(const QByteArray &ba, ParseOption opt, ObjectMode objMode, int maxThreads,
+                           std::size_t maxDepth)
+{
+    constexpr int MinBytes = 1 << 20; // the pre-scan is an extra pass over the input; skip it for small docs
+    constexpr int MinElems = 256;     // below this, thread spawn overhead dominates any speedup
+    unsigned nThreads = maxThreads > 0 ? unsigned(maxThreads) : std::thread::hardware_concurrency();
+    std::vector<std::pair<int, int>> elems;
+    if (ba.size() < MinBytes || nThreads <= 1 || !scanTopLevelArray(ba, elems) || int(elems.size()) < MinElems)
+        return parseUtf8(ba, opt, ParserBackend::Default, objMode, maxDepth);
+
+    // the pre-scan proved the root is an array, so this cannot be satisfied -- same message as parseUtf8
+    if (opt == ParseOption::RequireObject)
+        throw Error("Json Error: expected object");
+
+    const int nElems = int(elems.size());
+    nThreads = std::max(1U, std::min(nThreads, unsigned(nElems) / 64U));
+    // a few chunks per worker smooths out unevenly-sized elements; every chunk holds >= 1 element
+    const unsigned nChunks = std::min(nThreads * 4, unsigned(nElems));
+
+    // each element sits at depth 1 inside the root array, so its subtree gets one level less
+    const std::size_t elemMaxDepth = maxDepth > 0 ? maxDepth - 1 : 0;
+
+    std::vector<QVariantList> chunkLists(nChunks);
+    std::atomic_uint nextChunk{0};
+    std::atomic_bool failed{false};
+    std::exception_ptr firstError;
+    std::mutex errorMut;
+
+    const auto worker = [&] {
+        // per-thread context: the parse-tree arena, depth stack and key interner amortize across all
+        // the elements this thread processes (array-of-objects corpora repeat the same keys endlessly)
+        ParseContext ctx;
+        for (;;) {
+            const unsigned c = nextChunk.fetch_add(1, std::memory_order_relaxed);
+            if (c >= nChunks || failed.load(std::memory_order_relaxed))
+                return;
+            try {
+                const int lo = int(qint64(c) * nElems / nChunks), hi = int(qint64(c + 1) * nElems / nChunks);
+                QVariantList &lst = chunkLists[c];
+                lst.reserve(hi - lo);
+                for (int i = lo; i < hi; ++i) {
+                    const auto &[b, e] = elems[size_t(i)];
+                    // shallow view -- the parser takes deep copies of everything it keeps
+                    lst.push_back(ctx.parse(QByteArray::fromRawData(ba.constData() + b, e - b),
+                                            ParseOption::AcceptAnyValue, objMode, elemMaxDepth));
+                }
+            } catch (...) {
+                failed = true;
+                std::unique_lock g(errorMut);
+                if (!firstError)
+                    firstError = std::current_exception();
+                return;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(nThreads - 1);
+    for (unsigned t = 0; t + 1 < nThreads; ++t)
+        threads.emplace_back(worker);
+    worker(); // the calling thread participates too
+    for (auto &thr : threads)
+        thr.join();
+
+    if (failed)
+        std::rethrow_exception(firstError);
+
+    // ordered (scatter/gather) stitch into the final list
+    QVariantList ret;
+    ret.reserve(nElems);
+    for (auto &lst : chunkLists)
+        for (auto &var : lst)
+            ret.push_back(std::move(var));
+    return ret;
+}
+
+namespace detail {
+
+namespace {
+/// May throw ParserUnavailable if the simdjson parser is not compiled-in
+bool sjParse(QVariant &out, const QByteArray &bytes, ObjectMode objMode);
+}
+
+bool parse(QVariant &out, const QByteArray &bytes, ParserBackend backend, ObjectMode objMode,
+           std::size_t maxDepth)
+{
+    if (backend == ParserBackend::SimdJson
+            || (backend == ParserBackend::FastestAvailable && isParserAvailable(ParserBackend::SimdJson))) {
+        JSON_STAT_ADD(parsesSimdJson, 1);
+        return sjParse(out, bytes, objMode);
+    }
+
+    JSON_STAT_ADD(parsesDefault, 1);
+
+    // "Default" (internal) parser implementation below
+
+    out = QVariant{}; // ensure cleared
+
+    ParserState ps;
+    ps.maxDepth = maxDepth;
+
+    QByteArray tokenVal;
+    unsigned consumed;
+    const char *raw = bytes.constData();
+    const char * const end = raw + bytes.size();
+    do {
+        /* Note: getJsonToken modifies `tokenVal` *only if* return val was
+         * JTOK_NUMBER or JTOK_STRING, but it may also modify it on JTOK_ERR,
+         * leaving `tokenVal` in an unspecified state. */
+        const jtokentype tok = getJsonToken(tokenVal, consumed, raw, end);
+        if (tok == JTOK_NONE || tok == JTOK_ERR)
+            return false;
+        raw += consumed;
+
+        if (!ps.processToken(tok, tokenVal))
+            return false;
+    } while (!ps.stack.empty());
+
+    /* Check that nothing follows the initial construct (parsed above).  */
+    if (getJsonToken(tokenVal, consumed, raw, end) != JTOK_NONE)
         return false;
 
     try {
-        out = root.toVariant(); // convert to (possibly nested) QVariant containing QVariants
+        out = ps.root.takeVariant(objMode); // convert to (possibly nested) QVariant containing QVariants
     } catch (const std::exception &e) {
         // this is unlikely to happen, but may if std::bad_alloc (or if bugs in this code).
         qWarning() << "Failed to parse JSON: " << e.what();
@@ -936,15 +1990,13 @@ bool parse(QVariant &out, const QByteArray &bytes, ParserBackend backend)
     }
 
     return true;
-#   undef expect
-#   undef setExpect
-#   undef clearExpect
 }
 
 namespace {
 #if HAVE_SIMDJSON
-QVariant sjToVariant(const simdjson::dom::element &e)
+QVariant sjToVariant(const simdjson::dom::element &e, KeyInterner &interner, const ObjectMode objMode)
 {
+    JSON_STAT_ADD(valuesCreated, 1);
     QVariant var;
     using T = simdjson::dom::element_type;
     switch (e.type()) {
@@ -954,17 +2006,25 @@ QVariant sjToVariant(const simdjson::dom::element &e)
         auto && arr = res.value();
         l.reserve(arr.size());
         for (const auto &e2 : arr)
-            l.push_back(sjToVariant(e2));
+            l.push_back(sjToVariant(e2, interner, objMode));
         var = l;
         break;
     }
     case T::OBJECT: {
-        QVariantMap m;
         auto && res = e.get_object();
         auto && o = res.value();
-        for (auto && [k, v] : o)
-            m.insert(QString::fromUtf8(k.data(), k.size()), sjToVariant(v));
-        var = m;
+        if (objMode == ObjectMode::HashObjects) {
+            QVariantHash h;
+            h.reserve(int(o.size())); // known entry count -- avoids rehashes
+            for (auto && [k, v] : o)
+                h.insert(interner.intern(QByteArray::fromRawData(k.data(), int(k.size()))), sjToVariant(v, interner, objMode));
+            var = h;
+        } else {
+            QVariantMap m;
+            for (auto && [k, v] : o)
+                m.insert(interner.intern(QByteArray::fromRawData(k.data(), int(k.size()))), sjToVariant(v, interner, objMode));
+            var = m;
+        }
         break;
     }
     case T::INT64:
@@ -991,27 +2051,309 @@ QVariant sjToVariant(const simdjson::dom::element &e)
     }
     return var;
 }
+
+QVariant sjToVariant(const simdjson::dom::element &e, const ObjectMode objMode = ObjectMode::MapObjects)
+{
+    KeyInterner interner; // per-conversion key intern table (see KeyInterner above)
+    return sjToVariant(e, interner, objMode);
+}
 #endif
 
 // does not normally throw unless !HAVE_SIMDJSON in which case it always throws ParserUnavailable
-bool sjParse(QVariant &out, const QByteArray &bytes)
+bool sjParse(QVariant &out, const QByteArray &bytes, const ObjectMode objMode)
 {
 #if HAVE_SIMDJSON
-    simdjson::dom::parser parser;
+    // One long-lived parser per thread: simdjson reuses its internal buffers across parses, so the
+    // capacity grows to the high-water mark once and subsequent parses do no allocation at all.
+    // This is safe because the dom::element tree is fully converted to QVariants below before we
+    // return (nothing outlives this call that points into the parser's buffers) -- Json::Document,
+    // which *does* keep the dom tree alive, deliberately owns its own parser instance instead.
+    thread_local simdjson::dom::parser parser;
     simdjson::dom::element elem;
     auto error = parser.parse(std::string_view{bytes.data(), size_t(bytes.size())}).get(elem);
     if (error)
         return false;
-    out = sjToVariant(elem);
+    out = sjToVariant(elem, objMode);
     return true;
 #else
-    (void)out; (void)bytes;
+    (void)out; (void)bytes; (void)objMode;
     throw ParserUnavailable("Json Error: The SimdJson parser is not available");
 #endif
 }
 } // namespace
 } // namespace detail
 
+namespace {
+
+/// Splits an RFC 6901 JSON Pointer into its unescaped reference tokens (as utf8, for comparison
+/// against the tokenizer's decoded key strings). An empty pointer yields zero tokens and addresses
+/// the whole document. Throws Error on syntax errors (missing leading '/', bad '~' escape).
+std::vector<QByteArray> splitJsonPointer(const QStringView ptr)
+{
+    std::vector<QByteArray> components;
+    if (ptr.isEmpty())
+        return components;
+    if (UNLIKELY(ptr[0] != QChar('/')))
+        throw Json::Error(QString("Json Error: bad JSON Pointer \"%1\" (must be empty or begin with '/')")
+                          .arg(ptr.toString()));
+    QString component;
+    const auto flush = [&components, &component] {
+        components.push_back(component.toUtf8());
+        component.clear();
+    };
+    for (int i = 1; i < ptr.size(); ++i) {
+        const QChar c = ptr[i];
+        if (c == QChar('/'))
+            flush();
+        else if (c == QChar('~')) {
+            const QChar esc = ++i < ptr.size() ? ptr[i] : QChar();
+            if (esc == QChar('0'))
+                component += QChar('~');
+            else if (esc == QChar('1'))
+                component += QChar('/');
+            else
+                throw Json::Error(QString("Json Error: bad JSON Pointer \"%1\" (invalid '~' escape)")
+                                  .arg(ptr.toString()));
+        } else
+            component += c;
+    }
+    flush(); // note: a trailing '/' correctly yields an empty final token (the key "")
+    return components;
+}
+
+/// Consumes exactly one complete JSON value (scalar or container) from the token stream, verifying
+/// only token-level bracket structure -- which is all that skipping an off-path subtree requires.
+/// Returns false on a malformed/truncated stream or if the next token does not start a value.
+bool skipJsonValue(QByteArray &tokenVal, const char *&raw, const char * const end)
+{
+    unsigned consumed;
+    int depth = 0;
+    bool first = true;
+    do {
+        const jtokentype tok = getJsonToken(tokenVal, consumed, raw, end);
+        if (tok == JTOK_NONE || tok == JTOK_ERR)
+            return false;
+        if (UNLIKELY(first && (tok == JTOK_COLON || tok == JTOK_COMMA || tok == JTOK_OBJ_CLOSE || tok == JTOK_ARR_CLOSE)))
+            return false; // not a value position
+        first = false;
+        raw += consumed;
+        if (tok == JTOK_OBJ_OPEN || tok == JTOK_ARR_OPEN)
+            ++depth;
+        else if (tok == JTOK_OBJ_CLOSE || tok == JTOK_ARR_CLOSE) {
+            if (UNLIKELY(--depth < 0))
+                return false;
+        }
+    } while (depth > 0);
+    return true;
+}
+
+} // namespace
+
+QVariant extract(const QByteArray &json, const QStringView pointer, const ParserBackend backend)
+{
+    if (UNLIKELY(!isParserAvailable(backend)))
+        throw ParserUnavailable("Json Error: The SimdJson parser is not available");
+    const auto path = splitJsonPointer(pointer); // validates pointer syntax up-front; may throw Error
+
+    const auto Malformed = [&json] {
+        return ParseError(QString("Failed to parse Json from string: %1%2").arg(QString(json.left(80)))
+                          .arg(json.size() > 80 ? "..." : ""));
+    };
+    const auto NotFound = [&pointer] {
+        return Error(QString("Json Error: no value exists at path \"%1\"").arg(pointer.toString()));
+    };
+
+    if (backend == ParserBackend::SimdJson
+            || (backend == ParserBackend::FastestAvailable && isParserAvailable(ParserBackend::SimdJson))) {
+#if HAVE_SIMDJSON
+        // simdjson materializes its internal tape for the whole document (that's its model), but
+        // at_pointer() resolution plus the single sjToVariant() below still allocate no off-path
+        // QVariants, which is where the bulk of a full parse's cost lives.
+        JSON_STAT_ADD(parsesSimdJson, 1);
+        thread_local simdjson::dom::parser parser; // per-thread buffer reuse; see the comment in sjParse()
+        simdjson::dom::element root, elem;
+        if (parser.parse(std::string_view{json.data(), size_t(json.size())}).get(root))
+            throw Malformed();
+        const QByteArray utf8 = pointer.toUtf8();
+        if (root.at_pointer(std::string_view{utf8.constData(), size_t(utf8.size())}).get(elem))
+            throw NotFound();
+        return detail::sjToVariant(elem);
+#else
+        throw ParserUnavailable("Json Error: The SimdJson parser is not available"); // unreachable; guarded above
+#endif
+    }
+
+    // Default backend: walk the token stream, descending only along the path
+    QByteArray tokenVal;
+    unsigned consumed;
+    const char *raw = json.constData();
+    const char * const end = raw + json.size();
+
+    for (const QByteArray &want : path) {
+        const jtokentype tok = getJsonToken(tokenVal, consumed, raw, end);
+        if (tok == JTOK_NONE || tok == JTOK_ERR)
+            throw Malformed();
+        raw += consumed;
+        if (tok == JTOK_OBJ_OPEN) {
+            bool firstMember = true;
+            for (;;) {
+                jtokentype t = getJsonToken(tokenVal, consumed, raw, end);
+                if (t == JTOK_NONE || t == JTOK_ERR)
+                    throw Malformed();
+                raw += consumed;
+                if (t == JTOK_OBJ_CLOSE) // empty object, or we scanned every member without a match
+                    throw NotFound();
+                if (!firstMember) {
+                    if (t != JTOK_COMMA)
+                        throw Malformed();
+                    t = getJsonToken(tokenVal, consumed, raw, end);
+                    if (t == JTOK_NONE || t == JTOK_ERR)
+                        throw Malformed();
+                    raw += consumed;
+                }
+                firstMember = false;
+                if (t != JTOK_STRING)
+                    throw Malformed();
+                const bool match = tokenVal == want;
+                if (getJsonToken(tokenVal, consumed, raw, end) != JTOK_COLON)
+                    throw Malformed();
+                raw += consumed;
+                if (match)
+                    break; // descend into this member's value
+                if (!skipJsonValue(tokenVal, raw, end))
+                    throw Malformed();
+            }
+        } else if (tok == JTOK_ARR_OPEN) {
+            // array reference tokens must be plain decimal indices with no leading zeros (RFC 6901);
+            // anything else (including the past-the-end "-" token) matches no element
+            int targetIdx = 0;
+            {
+                bool validIdx = !want.isEmpty() && (want.size() == 1 || want[0] != '0');
+                for (int i = 0; validIdx && i < want.size(); ++i) {
+                    if (!json_isdigit(uint8_t(want[i])) || targetIdx > (std::numeric_limits<int>::max() - 9) / 10)
+                        validIdx = false;
+                    else
+                        targetIdx = targetIdx * 10 + (want[i] - '0');
+                }
+                if (!validIdx)
+                    throw NotFound();
+            }
+            // peek: an immediately-closing bracket means the (empty) array cannot hold any index
+            if (getJsonToken(tokenVal, consumed, raw, end) == JTOK_ARR_CLOSE) {
+                raw += consumed;
+                throw NotFound();
+            }
+            for (int i = 0; i < targetIdx; ++i) {
+                if (!skipJsonValue(tokenVal, raw, end))
+                    throw Malformed();
+                const jtokentype t = getJsonToken(tokenVal, consumed, raw, end);
+                if (t == JTOK_NONE || t == JTOK_ERR)
+                    throw Malformed();
+                raw += consumed;
+                if (t == JTOK_ARR_CLOSE)
+                    throw NotFound(); // index is past the end of the array
+                if (t != JTOK_COMMA)
+                    throw Malformed();
+            }
+            // raw is now positioned at element `targetIdx`; descend
+        } else if (tok == JTOK_COLON || tok == JTOK_COMMA || tok == JTOK_OBJ_CLOSE || tok == JTOK_ARR_CLOSE) {
+            throw Malformed();
+        } else {
+            throw NotFound(); // path descends into a scalar
+        }
+    }
+
+    // raw is positioned at the target value: find its extent, then parse only that slice
+    const char * const valBegin = raw;
+    if (!skipJsonValue(tokenVal, raw, end))
+        throw Malformed();
+    QVariant ret;
+    // shallow view -- detail::parse takes deep copies of everything it keeps
+    if (!detail::parse(ret, QByteArray::fromRawData(valBegin, int(raw - valBegin)), ParserBackend::Default))
+        throw Malformed();
+    return ret;
+}
+
+struct Document::Impl {
+#if HAVE_SIMDJSON
+    simdjson::dom::parser parser; ///< owns the document tape; must outlive `root` (and any Value cursors)
+    simdjson::dom::element root;
+#endif
+};
+
+Document::Document() {}
+Document::~Document() {}
+Document::Document(Document &&) noexcept = default;
+Document &Document::operator=(Document &&) noexcept = default;
+
+bool Document::isValid() const noexcept { return bool(p); }
+
+Document Document::parse(const QByteArray &json)
+{
+#if HAVE_SIMDJSON
+    Document doc;
+    doc.p = std::make_unique<Impl>();
+    const auto error = doc.p->parser.parse(std::string_view{json.constData(), size_t(json.size())}).get(doc.p->root);
+    if (error)
+        throw ParseError(QString("Failed to parse Json from string: %1%2").arg(QString(json.left(80)))
+                         .arg(json.size() > 80 ? "..." : ""));
+    return doc;
+#else
+    (void)json;
+    throw ParserUnavailable("Json Error: The SimdJson parser is not available");
+#endif
+}
+
+Document::Value Document::Value::operator[](QStringView key) const
+{
+    QString component;
+    component.reserve(key.size() + 1);
+    component += QChar('/');
+    for (const QChar c : key) {
+        // RFC 6901 escaping for literal '~' and '/' inside a reference token
+        if (c == QChar('~'))
+            component += QLatin1String("~0");
+        else if (c == QChar('/'))
+            component += QLatin1String("~1");
+        else
+            component += c;
+    }
+    return Value{doc, ptr + component};
+}
+
+Document::Value Document::Value::operator[](int index) const
+{
+    return Value{doc, ptr + QChar('/') + QString::number(index)};
+}
+
+bool Document::Value::exists() const
+{
+#if HAVE_SIMDJSON
+    if (!doc || !doc->p)
+        return false;
+    const QByteArray utf8 = ptr.toUtf8();
+    return !doc->p->root.at_pointer(std::string_view{utf8.constData(), size_t(utf8.size())}).error();
+#else
+    return false;
+#endif
+}
+
+QVariant Document::Value::toVariant() const
+{
+#if HAVE_SIMDJSON
+    if (UNLIKELY(!doc || !doc->p))
+        throw Error("Json Error: Document is empty");
+    const QByteArray utf8 = ptr.toUtf8();
+    simdjson::dom::element elem;
+    const auto error = doc->p->root.at_pointer(std::string_view{utf8.constData(), size_t(utf8.size())}).get(elem);
+    if (error)
+        throw Error(QString("Json Error: no value exists at path \"%1\"").arg(ptr));
+    return detail::sjToVariant(elem);
+#else
+    throw ParserUnavailable("Json Error: The SimdJson parser is not available");
+#endif
+}
+
 namespace SimdJson {
 std::optional<const Info> getInfo()
 {
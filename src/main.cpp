@@ -25,6 +25,7 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 #include "Json.h"
 
+#include <QBuffer>
 #include <QByteArray>
 #include <QCoreApplication>
 #include <QDir>
@@ -32,9 +33,11 @@ WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <QFileInfo>
 #include <QJsonDocument>
 #include <QStringList>
+#include <QTemporaryFile>
 #include <QtDebug>
 #include <QTimer>
 
+#include <algorithm>
 #include <chrono>
 #include <cstdlib>
 #include <cstdint>
@@ -282,6 +285,444 @@ void test(const QString &dir, bool useSimdJson)
         Log() << "Basic tests: passed";
     }
     // /end basic tests
+    // parseEvents (SAX-style) tests
+    {
+        struct Counter : EventHandler {
+            int objs = 0, arrs = 0, keys = 0, strs = 0, nums = 0, bools = 0, nulls = 0;
+            QByteArray lastKey, height;
+            bool onObjectStart() override { ++objs; return true; }
+            bool onObjectEnd() override { return true; }
+            bool onArrayStart() override { ++arrs; return true; }
+            bool onArrayEnd() override { return true; }
+            bool onKey(const QByteArray &k) override { ++keys; lastKey = QByteArray{k.constData(), k.size()}; return true; }
+            bool onString(const QByteArray &) override { ++strs; return true; }
+            bool onNumber(const QByteArray &n) override {
+                ++nums;
+                if (lastKey == "height") height = QByteArray{n.constData(), n.size()};
+                return true;
+            }
+            bool onBool(bool) override { ++bools; return true; }
+            bool onNull() override { ++nulls; return true; }
+        };
+        Counter c;
+        const auto json = QByteArrayLiteral("{\"result\":{\"height\":556034,\"ok\":true,\"tx\":[\"aa\",\"bb\",null],\"x\":1.5}}");
+        if (!parseEvents(json, c)) throw Exception("parseEvents aborted unexpectedly");
+        if (c.objs != 2 || c.arrs != 1 || c.keys != 5 || c.strs != 2 || c.nums != 2 || c.bools != 1 || c.nulls != 1
+                || c.height != "556034")
+            throw Exception("parseEvents produced unexpected event counts");
+        // early abort: stop after the first key
+        struct Aborter : Counter { bool onKey(const QByteArray &) override { return false; } };
+        Aborter a;
+        if (parseEvents(json, a)) throw Exception("parseEvents was expected to abort");
+        bool didThrow = false;
+        try { parseEvents(QByteArrayLiteral("{\"unterminated\":"), c); } catch (const ParseError &) { didThrow = true; }
+        if (!didThrow) throw Exception("parseEvents was expected to throw on malformed input");
+        Log() << "parseEvents tests: passed";
+    }
+    // StreamParser (incremental parse) tests
+    {
+        const auto json = QByteArrayLiteral("{\"key\":[1,2.5,-3e2,\"str \\u00e9\\n\",true,false,null,{\"k\":\"v\"}],"
+                                            "\"num\":123456789,\"s\":\"hello world\"}  ");
+        const QVariant expected = parseUtf8(json, ParseOption::AcceptAnyValue, parser);
+        for (const int chunkSize : {1, 2, 3, 7, 64, 1 << 20}) {
+            StreamParser sp;
+            for (int i = 0; i < json.size(); i += chunkSize)
+                sp.feed(json.constData() + i, std::size_t(std::min(chunkSize, int(json.size()) - i)));
+            if (!sp.done()) throw Exception(QString("StreamParser not done (chunkSize=%1)").arg(chunkSize));
+            if (sp.result(ParseOption::RequireObject) != expected)
+                throw Exception(QString("StreamParser result mismatch (chunkSize=%1)").arg(chunkSize));
+        }
+        {
+            // a bare root number is only complete at end-of-input; result() supplies that signal
+            StreamParser sp;
+            sp.feed(QByteArrayLiteral("12"));
+            sp.feed(QByteArrayLiteral("34"));
+            if (sp.done()) throw Exception("StreamParser claimed done mid-number");
+            if (sp.result() != QVariant{qulonglong(1234)}) throw Exception("StreamParser number result mismatch");
+            sp.reset();
+            sp.feed(QByteArrayLiteral("[1,2"));
+            bool didThrow = false;
+            try { sp.result(); } catch (const ParseError &) { didThrow = true; }
+            if (!didThrow) throw Exception("StreamParser was expected to throw on truncated input");
+        }
+        {
+            // malformed input should throw from feed() as soon as it is detected
+            StreamParser sp;
+            bool didThrow = false;
+            try { sp.feed(QByteArrayLiteral("[1,]2")); } catch (const ParseError &) { didThrow = true; }
+            if (!didThrow) throw Exception("StreamParser was expected to throw on malformed input");
+        }
+        {
+            // a chunk ending in a bare '-' must stall (not error, not read past the buffer); the
+            // sign's digits may arrive with the next chunk
+            StreamParser sp;
+            sp.feed(QByteArrayLiteral("[1,-"));
+            sp.feed(QByteArrayLiteral("2]"));
+            if (!sp.done()) throw Exception("StreamParser not done after '-' split across chunks");
+            if (sp.result() != QVariant{QVariantList{qulonglong(1), qlonglong(-2)}})
+                throw Exception("StreamParser result mismatch for '-' split across chunks");
+        }
+        {
+            // a bare trailing '-' in a non-NUL-terminated buffer (as parseFile's mmap view may
+            // produce) must yield ParseError without reading past the end
+            const char minus[1] = {'-'};
+            bool didThrow = false;
+            try { parseUtf8(QByteArray::fromRawData(minus, 1)); } catch (const ParseError &) { didThrow = true; }
+            if (!didThrow) throw Exception("parseUtf8 was expected to throw on a bare '-'");
+        }
+        Log() << "StreamParser tests: passed";
+    }
+    // parseLines (NDJSON) tests
+    {
+        QByteArray ndjson;
+        QVariantList expected;
+        for (int i = 0; i < 1000; ++i) {
+            ndjson += QByteArray("{\"i\":") + QByteArray::number(i) + ",\"sq\":" + QByteArray::number(qlonglong(i) * i) + "}\n";
+            if (i % 100 == 99) ndjson += "\n   \n"; // blank lines should be skipped
+            expected.push_back(QVariantMap{{"i", qulonglong(i)}, {"sq", qulonglong(qlonglong(i) * i)}});
+        }
+        for (const int nThreads : {1, 0}) { // serial, then one worker per core
+            const auto res = parseLines(ndjson, parser, nThreads);
+            if (res != expected)
+                throw Exception(QString("parseLines result mismatch (maxThreads=%1)").arg(nThreads));
+        }
+        bool didThrow = false;
+        try { parseLines(QByteArrayLiteral("{\"ok\":1}\n{\"bad\":}\n"), parser); } catch (const ParseError &) { didThrow = true; }
+        if (!didThrow) throw Exception("parseLines was expected to throw on a malformed record");
+        Log() << "parseLines tests: passed";
+    }
+    // Document (lazy simdjson-backed handle) tests
+    if (isParserAvailable(ParserBackend::SimdJson)) {
+        const auto json = QByteArrayLiteral("{\"result\":{\"tip\":{\"height\":700000,\"hash\":\"00ab\"},"
+                                            "\"tx\":[{\"fee\":1.5},{\"fee\":2}]},\"k~ey/odd\":42}");
+        auto doc = Json::Document::parse(json);
+        if (!doc.isValid()) throw Exception("Document is not valid");
+        if (doc["result"]["tip"]["height"].toVariant() != QVariant{qlonglong(700000)})
+            throw Exception("Document field access mismatch (height)");
+        if (doc["result"]["tx"][1]["fee"].toVariant() != QVariant{qlonglong(2)})
+            throw Exception("Document array access mismatch (fee)");
+        if (doc["k~ey/odd"].toVariant() != QVariant{qlonglong(42)})
+            throw Exception("Document escaped-key access mismatch");
+        if (doc.atPointer(QStringLiteral("/result/tip/hash")).toVariant() != QVariant{QStringLiteral("00ab")})
+            throw Exception("Document atPointer mismatch");
+        if (doc["result"]["nope"].exists() || !doc["result"]["tip"].exists())
+            throw Exception("Document exists() mismatch");
+        if (doc.toVariant() != parseUtf8(json, ParseOption::AcceptAnyValue, ParserBackend::SimdJson))
+            throw Exception("Document full materialization mismatch");
+        bool didThrow = false;
+        try { doc["result"]["nope"].toVariant(); } catch (const Json::Error &) { didThrow = true; }
+        if (!didThrow) throw Exception("Document was expected to throw on a missing path");
+        Log() << "Document tests: passed";
+    }
+    // serializeToDevice (streaming serializer) tests
+    {
+        QVariantList big;
+        for (int i = 0; i < 5000; ++i)
+            big.push_back(QVariantMap{{"i", i}, {"s", QStringLiteral("value with \"escapes\" %1").arg(i)}});
+        for (const unsigned prettyIndent : {0u, 4u}) {
+            const QByteArray expected = serialize(big, prettyIndent);
+            QBuffer buf;
+            buf.open(QIODevice::WriteOnly);
+            serializeToDevice(big, buf, prettyIndent, 0, 4096 /* small chunkSize to exercise flushing */);
+            if (buf.data() != expected)
+                throw Exception(QString("serializeToDevice output mismatch (prettyIndent=%1)").arg(prettyIndent));
+        }
+        bool didThrow = false;
+        QBuffer closedBuf;
+        try { serializeToDevice(42, closedBuf); } catch (const Json::Error &) { didThrow = true; }
+        if (!didThrow) throw Exception("serializeToDevice was expected to throw on a non-writable device");
+        Log() << "serializeToDevice tests: passed";
+    }
+    // serializeParallel tests
+    {
+        QVariantList big;
+        for (int i = 0; i < 10000; ++i)
+            big.push_back(QVariantMap{{"txid", QStringLiteral("%1").arg(i, 64, 16, QChar('0'))},
+                                      {"fee", i * 0.25}, {"vsize", i}});
+        if (serializeParallel(big) != serialize(big, 0))
+            throw Exception("serializeParallel output differs from serialize");
+        if (serializeParallel(big, 4) != serialize(big, 4)) // pretty mode: serial fallback
+            throw Exception("serializeParallel pretty-mode output differs from serialize");
+        if (serializeParallel(QVariantMap{{"a", 1}}) != serialize(QVariantMap{{"a", 1}}, 0)) // non-array fallback
+            throw Exception("serializeParallel non-array output differs from serialize");
+        Log() << "serializeParallel tests: passed";
+    }
+    // parseFile tests (exercises the memory-mapped zero-copy path)
+    {
+        const QByteArray json = serialize(QVariantMap{{"key", QVariantList{1, 2.5, "three", QVariant{}}},
+                                                      {"nested", QVariantMap{{"a", true}}}}, 0);
+        QTemporaryFile tmp;
+        if (!tmp.open() || tmp.write(json) != json.size())
+            throw Exception("parseFile test: could not write temp file");
+        tmp.flush();
+        if (parseFile(tmp.fileName()) != parseUtf8(json))
+            throw Exception("parseFile result differs from parseUtf8");
+        Log() << "parseFile tests: passed";
+    }
+    // Json::Stats tests (counters only advance if built with JSON_ENABLE_STATS)
+    {
+        statsReset();
+        parseUtf8(QByteArrayLiteral("{\"a\":[1,2,3]}"));
+        serialize(QVariantMap{{"s", "needs \"escaping\""}}, 0);
+        const auto st = statsSnapshot();
+#ifdef JSON_ENABLE_STATS
+        if (!st.parsesDefault || !st.tokens || !st.bytesParsed || !st.valuesCreated || !st.escapeSlowPathHits)
+            throw Exception("Json::Stats counters did not advance");
+#else
+        if (st.parsesDefault || st.tokens || st.bytesParsed || st.valuesCreated || st.escapeSlowPathHits)
+            throw Exception("Json::Stats counters expected to be all-zero in this build");
+#endif
+        Log() << "stats tests: passed";
+    }
+    // ObjectMode::HashObjects tests
+    {
+        const auto json = QByteArrayLiteral("{\"a\":1,\"b\":[{\"c\":true},{\"c\":false}],\"d\":{\"e\":null}}");
+        const auto vh = parseUtf8(json, ParseOption::RequireObject, parser, ObjectMode::HashObjects);
+        if (vh.type() != QVariant::Hash)
+            throw Exception("HashObjects: expected a QVariantHash result");
+        const auto h = vh.toHash();
+        const auto m = parseUtf8(json, ParseOption::RequireObject, parser).toMap();
+        if (h.size() != m.size() || h["a"] != m["a"] || h["d"].toHash()["e"] != m["d"].toMap()["e"])
+            throw Exception("HashObjects: contents differ from the QVariantMap parse");
+        if (h["b"].toList().at(0).type() != QVariant::Hash)
+            throw Exception("HashObjects: nested objects should be hashes too");
+        // round trip: hash-mode output re-parses to the same tree (key order may differ, so compare via map mode)
+        if (parseUtf8(serialize(vh, 0), ParseOption::RequireObject, parser) != parseUtf8(json, ParseOption::RequireObject, parser))
+            throw Exception("HashObjects: round trip mismatch");
+        Log() << "ObjectMode::HashObjects tests: passed";
+    }
+    // runtime maxDepth tests (Default backend only: simdjson enforces its own internal limit)
+    {
+        constexpr int depth = 10000; // far beyond any sane recursion budget -- exercises the iterative conversion
+        QByteArray deep;
+        deep.reserve(depth * 2 + 1);
+        for (int i = 0; i < depth; ++i) deep += '[';
+        deep += '1';
+        for (int i = 0; i < depth; ++i) deep += ']';
+        bool didThrow = false;
+        try { parseUtf8(deep); } catch (const ParseError &) { didThrow = true; }
+        if (!didThrow) throw Exception("expected deep document to exceed DefaultMaxDepth");
+        auto v = parseUtf8(deep, ParseOption::AcceptAnyValue, ParserBackend::Default, ObjectMode::MapObjects, depth + 1);
+        int n = 0;
+        while (v.type() == QVariant::List) { const auto l = v.toList(); if (l.size() != 1) break; v = l.at(0); ++n; }
+        if (n != depth || v.toInt() != 1)
+            throw Exception("deep parse did not produce the expected nesting");
+        {
+            // error partway through a very deep document: the abandoned partial tree must be torn
+            // down iteratively (a recursive teardown at this depth would overflow the stack)
+            constexpr int errDepth = 300000;
+            QByteArray unterminated;
+            unterminated.reserve(errDepth);
+            for (int i = 0; i < errDepth; ++i) unterminated += '[';
+            didThrow = false;
+            try { parseUtf8(unterminated, ParseOption::AcceptAnyValue, ParserBackend::Default,
+                            ObjectMode::MapObjects, errDepth + 1); }
+            catch (const ParseError &) { didThrow = true; }
+            if (!didThrow) throw Exception("expected truncated deep document to throw ParseError");
+        }
+        Log() << "maxDepth tests: passed";
+    }
+    // ParseContext tests
+    {
+        ParseContext ctx;
+        for (int i = 0; i < 100; ++i) {
+            const QByteArray body = serialize(QVariantMap{{"id", i}, {"method", "ping"},
+                                                          {"params", QVariantList{i * 0.5, QVariant{}}}}, 0);
+            if (ctx.parse(body, ParseOption::RequireObject) != parseUtf8(body, ParseOption::RequireObject))
+                throw Exception("ParseContext result differs from parseUtf8");
+        }
+        if (ctx.parse(QByteArrayLiteral("{\"a\":1}"), ParseOption::AcceptAnyValue, ObjectMode::HashObjects).type() != QVariant::Hash)
+            throw Exception("ParseContext: HashObjects mode not honored");
+        bool didThrow = false;
+        try { ctx.parse(QByteArrayLiteral("{\"oops\":")); } catch (const ParseError &) { didThrow = true; }
+        if (!didThrow) throw Exception("ParseContext was expected to throw on malformed input");
+        // context must remain usable after an error
+        if (ctx.parse(QByteArrayLiteral("[1,2,3]")).toList().size() != 3)
+            throw Exception("ParseContext unusable after a failed parse");
+        Log() << "ParseContext tests: passed";
+    }
+    // Builder (streaming writer) tests
+    {
+        const QVariantMap tree{
+            {"id", 42},
+            {"name", QStringLiteral("needs \"escaping\" & a \\ too")},
+            {"ok", true},
+            {"nothing", QVariant{}},
+            {"pi", 3.14159},
+            {"results", QVariantList{1, -2, QStringLiteral("three"), QVariantMap{{"deep", QVariantList{}}}}},
+        };
+        for (const unsigned prettyIndent : {0u, 4u}) {
+            Builder b(prettyIndent);
+            {
+                auto o = b.objectScope();
+                b.key(u"id").value(42);
+                b.key(u"name").value(u"needs \"escaping\" & a \\ too");
+                b.key(u"nothing").value(nullptr);
+                b.key(u"ok").value(true);
+                b.key(u"pi").value(3.14159);
+                b.key(u"results");
+                {
+                    auto a = b.arrayScope();
+                    b.value(1).value(-2).value(u"three");
+                    auto o2 = b.objectScope();
+                    b.key(u"deep");
+                    b.arrayScope(); // empty array, closed immediately by the temporary's dtor
+                }
+            }
+            if (b.take() != serialize(tree, prettyIndent))
+                throw Exception(QString("Builder output differs from serialize (prettyIndent=%1)").arg(prettyIndent));
+            // Builder is reusable after take(); embedding a QVariant subtree must indent identically
+            b.beginArray();
+            b.value(QVariant{tree});
+            b.endArray();
+            if (b.take() != serialize(QVariantList{tree}, prettyIndent))
+                throw Exception(QString("Builder QVariant embedding differs from serialize (prettyIndent=%1)").arg(prettyIndent));
+        }
+        // misuse must throw Json::Error
+        {
+            Builder b;
+            b.beginObject();
+            bool didThrow = false;
+            try { b.value(1); } catch (const Json::Error &) { didThrow = true; }
+            if (!didThrow) throw Exception("Builder: value without key in an object should throw");
+        }
+        {
+            Builder b;
+            b.beginArray();
+            bool didThrow = false;
+            try { b.take(); } catch (const Json::Error &) { didThrow = true; }
+            if (!didThrow) throw Exception("Builder: take() with an open container should throw");
+            didThrow = false;
+            try { b.endObject(); } catch (const Json::Error &) { didThrow = true; }
+            if (!didThrow) throw Exception("Builder: mismatched endObject() should throw");
+        }
+        Log() << "Builder tests: passed";
+    }
+    // parseUtf8Parallel tests (the corpus must be > 1MiB with > 256 elements to engage the parallel path)
+    {
+        QVariantList big;
+        for (int i = 0; i < 20000; ++i)
+            big.push_back(QVariantMap{{"txid", QStringLiteral("%1").arg(i, 64, 16, QChar('0'))},
+                                      {"note", QStringLiteral("comma, \"bracket]\" and \\ test %1").arg(i)},
+                                      {"fee", i * 0.25}, {"sub", QVariantList{i, QVariant{}}}});
+        const QByteArray json = serialize(big, 0);
+        if (parseUtf8Parallel(json) != parseUtf8(json))
+            throw Exception("parseUtf8Parallel result differs from parseUtf8");
+        if (parseUtf8Parallel(json, ParseOption::RequireArray, ObjectMode::HashObjects) != parseUtf8(json, ParseOption::RequireArray, ParserBackend::Default, ObjectMode::HashObjects))
+            throw Exception("parseUtf8Parallel HashObjects result differs from parseUtf8");
+        // small inputs and non-array roots take the sequential fallback and must behave identically
+        if (parseUtf8Parallel(QByteArrayLiteral("{\"a\":[1,2]}")) != parseUtf8(QByteArrayLiteral("{\"a\":[1,2]}")))
+            throw Exception("parseUtf8Parallel fallback result differs from parseUtf8");
+        bool didThrow = false;
+        try { parseUtf8Parallel(json, ParseOption::RequireObject); } catch (const Json::Error &) { didThrow = true; }
+        if (!didThrow) throw Exception("parseUtf8Parallel was expected to throw on RequireObject for an array");
+        didThrow = false;
+        QByteArray bad = json; bad[bad.size() / 2] = '\x01'; // raw control char: invalid in and out of strings
+        try { parseUtf8Parallel(bad); } catch (const ParseError &) { didThrow = true; }
+        if (!didThrow) throw Exception("parseUtf8Parallel was expected to throw on corrupted input");
+        Log() << "parseUtf8Parallel tests: passed";
+    }
+    // toBinary / parseBinary tests
+    {
+        const QVariantMap tree{
+            {"i", qlonglong(-12345678901234ll)},
+            {"u", qulonglong(18446744073709551615ull)},
+            {"d", 3.141592653589793},
+            {"s", QStringLiteral("utf8 éü and \"quotes\"")},
+            {"b", QByteArray("raw bytes \x01\x02", 12)},
+            {"flags", QVariantList{true, false, QVariant{}}},
+            {"h", QVariant{QVariantHash{{"nested", QVariantList{1, 2}}}}},
+        };
+        const QByteArray blob = toBinary(tree);
+        const QVariant back = parseBinary(blob);
+        if (back != QVariant{tree})
+            throw Exception("toBinary/parseBinary round trip mismatch");
+        // QString vs QByteArray and QVariantMap vs QVariantHash must survive the round trip
+        const auto m = back.toMap();
+        if (m["s"].type() != QVariant::String || m["b"].type() != QVariant::ByteArray || m["h"].type() != QVariant::Hash)
+            throw Exception("toBinary/parseBinary did not preserve value types");
+        // serialize() conventions apply: empty QByteArray -> null, null QString -> ""
+        const auto conv = parseBinary(toBinary(QVariantList{QByteArray{}, QString{}})).toList();
+        if (!conv.at(0).isNull() || conv.at(1) != QStringLiteral(""))
+            throw Exception("toBinary/parseBinary special-case mapping mismatch");
+        for (const QByteArray &bad : { QByteArray{}, QByteArrayLiteral("not a blob"), blob.left(blob.size() - 1) }) {
+            bool didThrow = false;
+            try { parseBinary(bad); } catch (const ParseError &) { didThrow = true; }
+            if (!didThrow) throw Exception("parseBinary was expected to throw on malformed input");
+        }
+        {
+            QVariant deep = 1;
+            for (int i = 0; i < 600; ++i) deep = QVariantList{deep}; // > DefaultMaxDepth
+            const QByteArray deepBlob = toBinary(deep);
+            bool didThrow = false;
+            try { parseBinary(deepBlob); } catch (const ParseError &) { didThrow = true; }
+            if (!didThrow) throw Exception("parseBinary was expected to enforce maxDepth");
+            if (parseBinary(deepBlob, 601) != deep)
+                throw Exception("parseBinary deep round trip mismatch with raised maxDepth");
+        }
+        Log() << "toBinary/parseBinary tests: passed";
+    }
+    // extract (JSON Pointer) tests
+    {
+        const auto json = QByteArrayLiteral(
+            "{\"result\":{\"tip\":{\"height\":820123,\"hash\":\"00ff\"},\"peers\":[{\"id\":1},{\"id\":2},{\"id\":3}]},"
+            "\"a/b\":{\"c~d\":true},\"empty\":{},\"list\":[]}");
+        for (const auto backend : {ParserBackend::Default, parser}) {
+            if (extract(json, u"/result/tip/height", backend).toInt() != 820123)
+                throw Exception("extract: wrong value for /result/tip/height");
+            if (extract(json, u"/result/peers/2/id", backend).toInt() != 3)
+                throw Exception("extract: wrong value for /result/peers/2/id");
+            if (extract(json, u"/a~1b/c~0d", backend).toBool() != true) // RFC 6901 ~1 == '/', ~0 == '~'
+                throw Exception("extract: escaped pointer tokens mishandled");
+            if (extract(json, u"", backend) != parseUtf8(json)) // empty pointer == whole document
+                throw Exception("extract: empty pointer should yield the whole document");
+            if (extract(json, u"/result/tip", backend) != parseUtf8(json).toMap()["result"].toMap()["tip"])
+                throw Exception("extract: subtree extraction mismatch");
+            for (const auto &missing : {u"/nope", u"/result/peers/3", u"/result/peers/01", u"/empty/x", u"/list/0",
+                                        u"/result/tip/height/deeper"}) {
+                bool didThrow = false;
+                try { extract(json, missing, backend); } catch (const Json::Error &) { didThrow = true; }
+                if (!didThrow) throw Exception(QString("extract was expected to throw for pointer %1").arg(QStringView{missing}.toString()));
+            }
+            bool didThrow = false;
+            try { extract(json, u"no-leading-slash", backend); } catch (const Json::Error &) { didThrow = true; }
+            if (!didThrow) throw Exception("extract was expected to throw on an invalid pointer");
+        }
+        bool didThrow = false;
+        try { extract(QByteArrayLiteral("{\"a\":"), u"/a"); } catch (const ParseError &) { didThrow = true; }
+        if (!didThrow) throw Exception("extract was expected to throw ParseError on malformed input");
+        Log() << "extract tests: passed";
+    }
+    // parseCompressed tests (multi-chunk: the plaintext is larger than the 256KiB inflate window)
+    {
+        QVariantList big;
+        for (int i = 0; i < 5000; ++i)
+            big.push_back(QVariantMap{{"i", i}, {"pad", QStringLiteral("%1").arg(i, 128, 10, QChar('0'))}});
+        const QByteArray json = serialize(big, 0);
+        const QByteArray qz = qCompress(json);
+        if (parseCompressed(qz) != parseUtf8(json))
+            throw Exception("parseCompressed result differs from parseUtf8");
+        bool didThrow = false;
+        try { parseCompressed(qz, ParseOption::RequireObject); } catch (const Json::Error &) { didThrow = true; }
+        if (!didThrow) throw Exception("parseCompressed was expected to throw on RequireObject for an array");
+        didThrow = false;
+        try { parseCompressed(qz.left(qz.size() / 2)); } catch (const ParseError &) { didThrow = true; }
+        if (!didThrow) throw Exception("parseCompressed was expected to throw on a truncated stream");
+        didThrow = false;
+        try { parseCompressed(QByteArrayLiteral("not compressed at all")); } catch (const ParseError &) { didThrow = true; }
+        if (!didThrow) throw Exception("parseCompressed was expected to throw on garbage input");
+        // parseFile routes *.qz through the decompressing path, honoring non-default options too
+        QTemporaryFile tmp(QDir::tempPath() + QLatin1String("/json_test_XXXXXX.qz"));
+        if (!tmp.open() || tmp.write(qz) != qz.size())
+            throw Exception("parseCompressed test: could not write temp file");
+        tmp.flush();
+        if (parseFile(tmp.fileName()) != parseUtf8(json))
+            throw Exception("parseFile(.qz) result differs from parseUtf8");
+        if (parseFile(tmp.fileName(), ParseOption::AcceptAnyValue, ParserBackend::Default, ObjectMode::HashObjects)
+                .toList().at(0).type() != QVariant::Hash)
+            throw Exception("parseFile(.qz) did not honor ObjectMode::HashObjects");
+        Log() << "parseCompressed tests: passed";
+    }
     QDir dataDir(dir);
     if (!dataDir.exists()) throw BadArgs(QString("DATADIR '%1' does not exist").arg(dir));
     struct TFile {